@@ -45,6 +45,7 @@ fi
 
 SOURCES=(
 	"cli/tasks/cue.cpp"
+	"cli/tasks/image.cpp"
 	"cli/tasks/iso.cpp"
 	"cli/tasks/mds.cpp"
 	"cli/tasks/odi.cpp"
@@ -67,6 +68,8 @@ SOURCES=(
 	"lib/exceptions.cpp"
 	"lib/idiv.cpp"
 	"lib/iso9660.cpp"
+	"lib/journal.cpp"
+	"lib/lpc.cpp"
 	"lib/mds.cpp"
 	"lib/memory.cpp"
 	"lib/odi.cpp"
@@ -74,9 +77,12 @@ SOURCES=(
 	"lib/overdrive.cpp"
 	"lib/path.cpp"
 	"lib/parser.cpp"
+	"lib/pipeline.cpp"
+	"lib/pool.cpp"
 	"lib/scsi.cpp"
 	"lib/sense.cpp"
 	"lib/shared.cpp"
+	"lib/simd.cpp"
 	"lib/string.cpp"
 	"lib/task.cpp"
 	"lib/time.cpp"
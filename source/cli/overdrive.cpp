@@ -4,6 +4,7 @@
 #include <vector>
 #include "../lib/overdrive.h"
 #include "tasks/cue.h"
+#include "tasks/image.h"
 #include "tasks/iso.h"
 #include "tasks/mds.h"
 #include "tasks/odi.h"
@@ -31,6 +32,11 @@ auto main(
 			"Archive disc using the ISO image format.",
 			tasks::iso
 		}));
+		tasks.push_back(task::Task({
+			"image",
+			"Archive disc using several image formats from a single extraction.",
+			tasks::image
+		}));
 		tasks.push_back(task::Task({
 			"mds",
 			"Archive disc using the MDF/MDS image format.",
@@ -3,21 +3,12 @@
 #include <cstdlib>
 #include <cstdio>
 #include <format>
+#include <map>
+#include <memory>
 #include <optional>
 #include <regex>
 
 namespace tasks {
-	class CUEOptions: public options::Options {
-		public:
-
-		std::optional<std::set<size_t>> track_numbers;
-		bool_t merge_tracks;
-		bool_t trim_data_tracks;
-		std::string audio_file_format;
-
-		protected:
-	};
-
 	namespace internal {
 	namespace {
 		auto parse_options(
@@ -25,78 +16,7 @@ namespace tasks {
 		) -> CUEOptions {
 			auto options = CUEOptions();
 			auto parsers = options::get_default_parsers(options);
-			parsers.push_back(parser::Parser({
-				"track-numbers",
-				{},
-				"Specify which track numbers to save.",
-				std::regex("^((?:[1-9]|[1-9][0-9])|(?:(?:[1-9]|[1-9][0-9])?[:](?:[1-9]|[1-9][0-9])?))$"),
-				"range<integer>",
-				false,
-				std::optional<std::string>(),
-				0,
-				99,
-				[&](const std::vector<std::string>& matches) -> void {
-					auto track_numbers = std::set<size_t>();
-					for (auto& match : matches) {
-						auto parts = string::split(match, ":");
-						if (parts.size() == 1) {
-							track_numbers.insert(std::atoi(parts.at(0).c_str()));
-						} else {
-							auto one = parts.at(0) == "" ? 1 : std::atoi(parts.at(0).c_str());
-							auto two = parts.at(1) == "" ? 99 : std::atoi(parts.at(1).c_str());
-							if (two < one) {
-								OVERDRIVE_THROW(exceptions::BadArgumentFormatException("track-numbers", "range<integer>"));
-							}
-							for (auto track_number = one; track_number <= two; track_number += 1) {
-								track_numbers.insert(track_number);
-							}
-						}
-					}
-					options.track_numbers = track_numbers;
-				}
-			}));
-			parsers.push_back(parser::Parser({
-				"merge-tracks",
-				{},
-				"Specify whether to merge all tracks into a single file.",
-				std::regex("^(true|false)$"),
-				"boolean",
-				false,
-				std::optional<std::string>("false"),
-				1,
-				1,
-				[&](const std::vector<std::string>& matches) -> void {
-					options.merge_tracks = matches.at(0) == "true";
-				}
-			}));
-			parsers.push_back(parser::Parser({
-				"trim-data-tracks",
-				{},
-				"Specify whether to trim sector data other than user data from data tracks.",
-				std::regex("^(true|false)$"),
-				"boolean",
-				false,
-				std::optional<std::string>("true"),
-				1,
-				1,
-				[&](const std::vector<std::string>& matches) -> void {
-					options.trim_data_tracks = matches.at(0) == "true";
-				}
-			}));
-			parsers.push_back(parser::Parser({
-				"audio-file-format",
-				{},
-				"Specify file format for audio tracks.",
-				std::regex("^(bin|wav)$"),
-				"bin|wav",
-				false,
-				std::optional<std::string>("wav"),
-				1,
-				1,
-				[&](const std::vector<std::string>& matches) -> void {
-					options.audio_file_format = matches.at(0);
-				}
-			}));
+			vector::append(parsers, get_cue_parsers(options));
 			parsers = parser::sort(parsers);
 			try {
 				parser::parse(arguments, parsers);
@@ -149,36 +69,6 @@ namespace tasks {
 			OVERDRIVE_THROW(exceptions::UnreachableCodeReachedException());
 		}
 
-		auto write_merged_bin(
-			const drive::Drive& drive,
-			const std::vector<disc::TrackInfo>& tracks,
-			const CUEOptions& options
-		) -> void {
-			auto path = path::create_path(options.path)
-				.with_extension(".bin")
-				.create_directories();
-			auto handle = archiver::open_handle(path);
-			try {
-				for (auto track_index = size_t(0); track_index < tracks.size(); track_index += 1) {
-					auto& track = tracks.at(track_index);
-					auto extracted_sectors_vector = archiver::read_track(drive, track, options);
-					auto bad_sector_indices = archiver::get_bad_sector_indices(extracted_sectors_vector, track.first_sector_absolute);
-					archiver::log_bad_sector_indices(drive, track, bad_sector_indices);
-					if (disc::is_data_track(track.type)) {
-						auto sector_data_offset = options.trim_data_tracks ? disc::get_user_data_offset(track.type) : 0;
-						auto sector_data_length = options.trim_data_tracks ? disc::get_user_data_length(track.type) : cd::SECTOR_LENGTH;
-						archiver::append_sector_data(extracted_sectors_vector, path, sector_data_offset, sector_data_length, handle, false);
-					} else {
-						archiver::append_sector_data(extracted_sectors_vector, path, 0, cd::SECTOR_LENGTH, handle, false);
-					}
-				}
-			}  catch (...) {
-				archiver::close_handle(handle);
-				throw;
-			}
-			archiver::close_handle(handle);
-		}
-
 		auto write_merged_cue(
 			const std::vector<disc::TrackInfo>& tracks,
 			const CUEOptions& options
@@ -214,45 +104,6 @@ namespace tasks {
 			archiver::close_handle(handle);
 		}
 
-		auto write_bin(
-			const drive::Drive& drive,
-			const std::vector<disc::TrackInfo>& tracks,
-			const CUEOptions& options
-		) -> void {
-			for (auto track_index = size_t(0); track_index < tracks.size(); track_index += 1) {
-				auto& track = tracks.at(track_index);
-				auto extracted_sectors_vector = archiver::read_track(drive, track, options);
-				auto bad_sector_indices = archiver::get_bad_sector_indices(extracted_sectors_vector, track.first_sector_absolute);
-				archiver::log_bad_sector_indices(drive, track, bad_sector_indices);
-				if (disc::is_data_track(track.type)) {
-					auto sector_data_offset = options.trim_data_tracks ? disc::get_user_data_offset(track.type) : 0;
-					auto sector_data_length = options.trim_data_tracks ? disc::get_user_data_length(track.type) : cd::SECTOR_LENGTH;
-					auto path = path::create_path(options.path)
-						.with_extension(std::format(".{:0>2}.bin", track.number))
-						.create_directories();
-					auto handle = archiver::open_handle(path);
-					archiver::append_sector_data(extracted_sectors_vector, path, sector_data_offset, sector_data_length, handle, false);
-					archiver::close_handle(handle);
-				} else {
-					auto extension = options.audio_file_format == "wav" ? "wav" : "bin";
-					auto path = path::create_path(options.path)
-						.with_extension(std::format(".{:0>2}.{}", track.number, extension))
-						.create_directories();
-					auto handle = archiver::open_handle(path);
-					if (options.audio_file_format == "wav") {
-						auto header = wav::Header();
-						header.data_length = cd::SECTOR_LENGTH * track.length_sectors;
-						header.riff_length = header.data_length + sizeof(wav::Header) - offsetof(wav::Header, wave_identifier);
-						if (std::fwrite(&header, sizeof(wav::Header), 1, handle) != 1) {
-							OVERDRIVE_THROW(exceptions::IOWriteException(path));
-						}
-					}
-					archiver::append_sector_data(extracted_sectors_vector, path, 0, cd::SECTOR_LENGTH, handle, false);
-					archiver::close_handle(handle);
-				}
-			}
-		}
-
 		auto write_cue(
 			const std::vector<disc::TrackInfo>& tracks,
 			const CUEOptions& options
@@ -303,7 +154,171 @@ namespace tasks {
 			}
 			archiver::close_handle(handle);
 		}
+
+		class CUEWriterState {
+			public:
+
+			~CUEWriterState(
+			) {
+				this->close();
+			}
+
+			auto close(
+			) -> void {
+				for (auto handle : this->handles) {
+					archiver::close_handle(handle);
+				}
+				this->handles.clear();
+			}
+
+			std::vector<std::string> paths;
+			std::vector<std::FILE*> handles;
+			std::map<size_t, size_t> handle_indices;
+
+			protected:
+		};
+	}
 	}
+
+	auto get_cue_parsers(
+		CUEOptions& options
+	) -> std::vector<parser::Parser> {
+		auto parsers = std::vector<parser::Parser>();
+		parsers.push_back(parser::Parser({
+			"track-numbers",
+			{},
+			"Specify which track numbers to save.",
+			std::regex("^((?:[1-9]|[1-9][0-9])|(?:(?:[1-9]|[1-9][0-9])?[:](?:[1-9]|[1-9][0-9])?))$"),
+			"range<integer>",
+			false,
+			std::optional<std::string>(),
+			0,
+			99,
+			[&](const std::vector<std::string>& matches) -> void {
+				auto track_numbers = std::set<size_t>();
+				for (auto& match : matches) {
+					auto parts = string::split(match, ":");
+					if (parts.size() == 1) {
+						track_numbers.insert(std::atoi(parts.at(0).c_str()));
+					} else {
+						auto one = parts.at(0) == "" ? 1 : std::atoi(parts.at(0).c_str());
+						auto two = parts.at(1) == "" ? 99 : std::atoi(parts.at(1).c_str());
+						if (two < one) {
+							OVERDRIVE_THROW(exceptions::BadArgumentFormatException("track-numbers", "range<integer>"));
+						}
+						for (auto track_number = one; track_number <= two; track_number += 1) {
+							track_numbers.insert(track_number);
+						}
+					}
+				}
+				options.track_numbers = track_numbers;
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"merge-tracks",
+			{},
+			"Specify whether to merge all tracks into a single file.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("false"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.merge_tracks = matches.at(0) == "true";
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"trim-data-tracks",
+			{},
+			"Specify whether to trim sector data other than user data from data tracks.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("true"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.trim_data_tracks = matches.at(0) == "true";
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"audio-file-format",
+			{},
+			"Specify file format for audio tracks.",
+			std::regex("^(bin|wav)$"),
+			"bin|wav",
+			false,
+			std::optional<std::string>("wav"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.audio_file_format = matches.at(0);
+			}
+		}));
+		return parsers;
+	}
+
+	auto create_cue_writer(
+		const drive::Drive& drive,
+		const disc::DiscInfo& disc_info,
+		const CUEOptions& options
+	) -> ImageWriter {
+		auto tracks = disc::get_disc_tracks(disc_info, options.track_numbers);
+		internal::assert_image_compatibility(tracks);
+		auto toc = drive.read_normal_toc();
+		internal::write_toc(toc, options);
+		auto state = std::make_shared<internal::CUEWriterState>();
+		if (options.merge_tracks) {
+			auto path = path::create_path(options.path)
+				.with_extension(".bin")
+				.create_directories();
+			state->paths.push_back(path);
+			state->handles.push_back(archiver::open_handle(path));
+			for (auto& track : tracks) {
+				state->handle_indices[track.number] = 0;
+			}
+			OVERDRIVE_LOG("Saving track sector data to \"{}\"", std::string(path));
+		} else {
+			for (auto& track : tracks) {
+				auto extension = disc::is_data_track(track.type) ? "bin" : options.audio_file_format == "wav" ? "wav" : "bin";
+				auto path = path::create_path(options.path)
+					.with_extension(std::format(".{:0>2}.{}", track.number, extension))
+					.create_directories();
+				state->paths.push_back(path);
+				state->handles.push_back(archiver::open_handle(path));
+				state->handle_indices[track.number] = state->handles.size() - 1;
+				if (disc::is_audio_track(track.type) && options.audio_file_format == "wav") {
+					auto header = wav::Header();
+					header.data_length = cd::SECTOR_LENGTH * track.length_sectors;
+					header.riff_length = header.data_length + sizeof(wav::Header) - offsetof(wav::Header, wave_identifier);
+					if (std::fwrite(&header, sizeof(wav::Header), 1, state->handles.back()) != 1) {
+						OVERDRIVE_THROW(exceptions::IOWriteException(path));
+					}
+				}
+				OVERDRIVE_LOG("Saving track sector data to \"{}\"", std::string(path));
+			}
+		}
+		auto writer = ImageWriter();
+		writer.tracks = tracks;
+		writer.write_track_sector = [=](const disc::TrackInfo& track, si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+			(void)sector_index;
+			(void)is_readable;
+			auto handle_index = state->handle_indices.at(track.number);
+			auto is_trimmed = options.trim_data_tracks && disc::is_data_track(track.type);
+			auto sector_data_offset = is_trimmed ? disc::get_user_data_offset(track.type) : 0;
+			auto sector_data_length = is_trimmed ? disc::get_user_data_length(track.type) : cd::SECTOR_LENGTH;
+			archiver::append_sector_data(extracted_sector, state->paths.at(handle_index), sector_data_offset, sector_data_length, state->handles.at(handle_index), false);
+		};
+		writer.finish = [=]() -> void {
+			state->close();
+			if (options.merge_tracks) {
+				internal::write_merged_cue(tracks, options);
+			} else {
+				internal::write_cue(tracks, options);
+			}
+		};
+		return writer;
 	}
 
 	auto cue(
@@ -312,7 +327,7 @@ namespace tasks {
 		auto options = internal::parse_options(arguments);
 		auto detail = options.drive.ends_with(".odi") ? odi::create_detail() : detail::create_detail();
 		auto drive_handle = detail.get_handle(options.drive);
-		auto drive = drive::create_drive(drive_handle, detail.ioctl);
+		auto drive = drive::create_drive(drive_handle, detail);
 		auto drive_info = drive.read_drive_info();
 		drive_info.print();
 		auto disc_info = drive.read_disc_info();
@@ -320,16 +335,16 @@ namespace tasks {
 		if (!options.read_correction) {
 			options.read_correction = drive_info.read_offset_correction;
 		}
-		auto tracks = disc::get_disc_tracks(disc_info, options.track_numbers);
-		internal::assert_image_compatibility(tracks);
-		auto toc = drive.read_normal_toc();
-		internal::write_toc(toc, options);
-		if (options.merge_tracks) {
-			internal::write_merged_bin(drive, tracks, options);
-			internal::write_merged_cue(tracks, options);
-		} else {
-			internal::write_bin(drive, tracks, options);
-			internal::write_cue(tracks, options);
+		auto accuraterip_lookup = options.accuraterip_database ? std::optional<accuraterip::Lookup>(accuraterip::create_lookup(disc_info, options.accuraterip_database.value())) : std::optional<accuraterip::Lookup>();
+		if (!options.read_correction && accuraterip_lookup) {
+			options.read_correction = archiver::detect_read_offset_correction(drive, disc_info, accuraterip_lookup.value(), options);
 		}
+		auto writer = create_cue_writer(drive, disc_info, options);
+		auto journal_path = path::create_path(options.path)
+			.with_extension(".journal")
+			.create_directories();
+		auto journal = journal::Journal(journal_path, journal::compute_fingerprint(disc_info, options.read_correction.value_or(0)), options.resume);
+		write_images(drive, journal, accuraterip_lookup ? &accuraterip_lookup.value() : nullptr, disc_info, options, { writer });
+		journal.discard();
 	};
 }
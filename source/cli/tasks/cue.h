@@ -1,13 +1,37 @@
 #pragma once
 
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 #include "../../lib/overdrive.h"
+#include "image.h"
 
 using namespace overdrive;
 using namespace shared;
 
 namespace tasks {
+	class CUEOptions: public options::Options {
+		public:
+
+		std::optional<std::set<size_t>> track_numbers;
+		bool_t merge_tracks;
+		bool_t trim_data_tracks;
+		std::string audio_file_format;
+
+		protected:
+	};
+
+	auto get_cue_parsers(
+		CUEOptions& options
+	) -> std::vector<parser::Parser>;
+
+	auto create_cue_writer(
+		const drive::Drive& drive,
+		const disc::DiscInfo& disc_info,
+		const CUEOptions& options
+	) -> ImageWriter;
+
 	auto cue(
 		const std::vector<std::string>& arguments
 	) -> void;
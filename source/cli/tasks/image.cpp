@@ -0,0 +1,196 @@
+#include "image.h"
+
+#include <algorithm>
+#include <optional>
+#include <regex>
+#include <set>
+#include "cue.h"
+#include "iso.h"
+#include "mds.h"
+#include "odi.h"
+
+namespace tasks {
+	class ImageOptions: public options::Options {
+		public:
+
+		std::set<std::string> formats;
+
+		protected:
+	};
+
+	namespace internal {
+	namespace {
+		auto parse_options(
+			const std::vector<std::string>& arguments,
+			CUEOptions& cue_options,
+			ISOOptions& iso_options,
+			MDSOptions& mds_options,
+			ODIptions& odi_options
+		) -> ImageOptions {
+			auto options = ImageOptions();
+			auto parsers = options::get_default_parsers(options);
+			parsers.push_back(parser::Parser({
+				"formats",
+				{},
+				"Specify which image formats to save.",
+				std::regex("^(cue|iso|mds|odi)$"),
+				"cue|iso|mds|odi",
+				false,
+				std::optional<std::string>(),
+				1,
+				4,
+				[&](const std::vector<std::string>& matches) -> void {
+					options.formats = std::set<std::string>(matches.begin(), matches.end());
+				}
+			}));
+			// Options shared by several formats are applied to all of them.
+			vector::append(parsers, get_cue_parsers(cue_options));
+			vector::append(parsers, get_iso_parsers(iso_options));
+			vector::append(parsers, get_mds_parsers(mds_options));
+			vector::append(parsers, get_odi_parsers(odi_options));
+			parsers = parser::sort(parsers);
+			try {
+				parser::parse(arguments, parsers);
+				return options;
+			} catch (const exceptions::ArgumentException& e) {
+				parser::print(parsers);
+				throw;
+			}
+		}
+	}
+	}
+
+	auto write_images(
+		const drive::Drive& drive,
+		journal::Journal& journal,
+		pointer<const accuraterip::Lookup> lookup,
+		const disc::DiscInfo& disc_info,
+		const options::Options& options,
+		const std::vector<ImageWriter>& writers
+	) -> void {
+		auto track_numbers = std::vector<std::set<size_t>>();
+		for (const auto& writer : writers) {
+			auto writer_track_numbers = std::set<size_t>();
+			for (const auto& track : writer.tracks) {
+				writer_track_numbers.insert(track.number);
+			}
+			track_numbers.push_back(writer_track_numbers);
+		}
+		auto writes_session_sectors = std::any_of(writers.begin(), writers.end(), [](const ImageWriter& writer) -> bool_t {
+			return bool_t(writer.write_session_sector);
+		});
+		auto write_session_range = [&](si_t first_sector, si_t last_sector) -> void {
+			if (!writes_session_sectors) {
+				return;
+			}
+			auto bad_sector_indices = archiver::stream_absolute_sector_range(
+				drive,
+				first_sector,
+				last_sector,
+				options.min_data_passes,
+				options.max_data_passes,
+				options.max_data_retries,
+				options.min_data_copies,
+				options.max_data_copies,
+				options.rescue,
+				options.max_memory,
+				&journal,
+				[&](si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+					for (const auto& writer : writers) {
+						if (writer.write_session_sector) {
+							writer.write_session_sector(sector_index, extracted_sector, is_readable);
+						}
+					}
+				}
+			);
+			OVERDRIVE_LOG("Sector range between {} and {} has {} bad sectors!", first_sector, last_sector, bad_sector_indices.size());
+		};
+		auto absolute_sector_offset = 0 - si_t(disc_info.sessions.front().lead_in_length_sectors);
+		for (auto session_index = size_t(0); session_index < disc_info.sessions.size(); session_index += 1) {
+			auto& session = disc_info.sessions.at(session_index);
+			write_session_range(absolute_sector_offset, absolute_sector_offset + session.lead_in_length_sectors);
+			absolute_sector_offset += session.lead_in_length_sectors;
+			write_session_range(absolute_sector_offset, absolute_sector_offset + session.pregap_sectors);
+			absolute_sector_offset += session.pregap_sectors;
+			auto tracks = vector::filter<disc::TrackInfo>(session.tracks, [&](const disc::TrackInfo& track, size_t) -> bool_t {
+				return std::any_of(track_numbers.begin(), track_numbers.end(), [&](const std::set<size_t>& writer_track_numbers) -> bool_t {
+					return writer_track_numbers.contains(track.number);
+				});
+			});
+			auto bad_sector_indices = archiver::stream_tracks(drive, tracks, options, lookup, &journal, [&](size_t track_index, si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+				auto& track = tracks.at(track_index);
+				for (auto writer_index = size_t(0); writer_index < writers.size(); writer_index += 1) {
+					if (track_numbers.at(writer_index).contains(track.number)) {
+						writers.at(writer_index).write_track_sector(track, sector_index, extracted_sector, is_readable);
+					}
+				}
+			});
+			for (auto track_index = size_t(0); track_index < tracks.size(); track_index += 1) {
+				auto& track = tracks.at(track_index);
+				archiver::log_bad_sector_indices(drive, track, bad_sector_indices.at(track_index));
+				for (auto writer_index = size_t(0); writer_index < writers.size(); writer_index += 1) {
+					auto& writer = writers.at(writer_index);
+					if (track_numbers.at(writer_index).contains(track.number) && writer.finish_track) {
+						writer.finish_track(track, bad_sector_indices.at(track_index));
+					}
+				}
+			}
+			for (const auto& track : session.tracks) {
+				absolute_sector_offset += track.length_sectors;
+			}
+			write_session_range(absolute_sector_offset, absolute_sector_offset + session.lead_out_length_sectors);
+			absolute_sector_offset += session.lead_out_length_sectors;
+		}
+		for (const auto& writer : writers) {
+			writer.finish();
+		}
+	}
+
+	auto image(
+		const std::vector<std::string>& arguments
+	) -> void {
+		auto cue_options = CUEOptions();
+		auto iso_options = ISOOptions();
+		auto mds_options = MDSOptions();
+		auto odi_options = ODIptions();
+		auto options = internal::parse_options(arguments, cue_options, iso_options, mds_options, odi_options);
+		auto detail = options.drive.ends_with(".odi") ? odi::create_detail() : detail::create_detail();
+		auto drive_handle = detail.get_handle(options.drive);
+		auto drive = drive::create_drive(drive_handle, detail);
+		auto drive_info = drive.read_drive_info();
+		drive_info.print();
+		auto disc_info = drive.read_disc_info();
+		disc_info.print();
+		if (!options.read_correction) {
+			options.read_correction = drive_info.read_offset_correction;
+		}
+		auto accuraterip_lookup = options.accuraterip_database ? std::optional<accuraterip::Lookup>(accuraterip::create_lookup(disc_info, options.accuraterip_database.value())) : std::optional<accuraterip::Lookup>();
+		if (!options.read_correction && accuraterip_lookup) {
+			options.read_correction = archiver::detect_read_offset_correction(drive, disc_info, accuraterip_lookup.value(), options);
+		}
+		static_cast<options::Options&>(cue_options) = options;
+		static_cast<options::Options&>(iso_options) = options;
+		static_cast<options::Options&>(mds_options) = options;
+		static_cast<options::Options&>(odi_options) = options;
+		// Writers are created before extracting in order to reject incompatible formats without reading the disc.
+		auto writers = std::vector<ImageWriter>();
+		if (options.formats.contains("cue")) {
+			writers.push_back(create_cue_writer(drive, disc_info, cue_options));
+		}
+		if (options.formats.contains("iso")) {
+			writers.push_back(create_iso_writer(disc_info, iso_options));
+		}
+		if (options.formats.contains("mds")) {
+			writers.push_back(create_mds_writer(disc_info, mds_options));
+		}
+		if (options.formats.contains("odi")) {
+			writers.push_back(create_odi_writer(disc_info, odi_options));
+		}
+		auto journal_path = path::create_path(options.path)
+			.with_extension(".journal")
+			.create_directories();
+		auto journal = journal::Journal(journal_path, journal::compute_fingerprint(disc_info, options.read_correction.value_or(0)), options.resume);
+		write_images(drive, journal, accuraterip_lookup ? &accuraterip_lookup.value() : nullptr, disc_info, options, writers);
+		journal.discard();
+	};
+}
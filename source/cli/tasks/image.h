@@ -0,0 +1,43 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include "../../lib/overdrive.h"
+
+using namespace overdrive;
+using namespace shared;
+
+namespace tasks {
+	using write_sector_t = std::function<void(si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable)>;
+	using write_track_sector_t = std::function<void(const disc::TrackInfo& track, si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable)>;
+	using finish_track_t = std::function<void(const disc::TrackInfo& track, const std::vector<size_t>& bad_sector_indices)>;
+	using finish_t = std::function<void()>;
+
+	class ImageWriter {
+		public:
+
+		std::vector<disc::TrackInfo> tracks;
+		// The lead-in, pregap and lead-out sectors are only extracted when at least one writer accepts them.
+		write_sector_t write_session_sector;
+		write_track_sector_t write_track_sector;
+		finish_track_t finish_track;
+		finish_t finish;
+
+		protected:
+	};
+
+	// Extracts the disc once and passes every extracted sector to the writers that accept it in disc order.
+	auto write_images(
+		const drive::Drive& drive,
+		journal::Journal& journal,
+		pointer<const accuraterip::Lookup> lookup,
+		const disc::DiscInfo& disc_info,
+		const options::Options& options,
+		const std::vector<ImageWriter>& writers
+	) -> void;
+
+	auto image(
+		const std::vector<std::string>& arguments
+	) -> void;
+}
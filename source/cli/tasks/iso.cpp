@@ -2,18 +2,12 @@
 
 #include <cstdlib>
 #include <format>
+#include <map>
+#include <memory>
 #include <optional>
 #include <regex>
 
 namespace tasks {
-	class ISOOptions: public options::Options {
-		public:
-
-		std::optional<std::set<size_t>> track_numbers;
-
-		protected:
-	};
-
 	namespace internal {
 	namespace {
 		auto parse_options(
@@ -21,36 +15,7 @@ namespace tasks {
 		) -> ISOOptions {
 			auto options = ISOOptions();
 			auto parsers = options::get_default_parsers(options);
-			parsers.push_back(parser::Parser({
-				"track-numbers",
-				{},
-				"Specify which track numbers to save.",
-				std::regex("^((?:[1-9]|[1-9][0-9])|(?:(?:[1-9]|[1-9][0-9])?[:](?:[1-9]|[1-9][0-9])?))$"),
-				"range<integer>",
-				false,
-				std::optional<std::string>(),
-				0,
-				99,
-				[&](const std::vector<std::string>& matches) -> void {
-					auto track_numbers = std::set<size_t>();
-					for (auto& match : matches) {
-						auto parts = string::split(match, ":");
-						if (parts.size() == 1) {
-							track_numbers.insert(std::atoi(parts.at(0).c_str()));
-						} else {
-							auto one = parts.at(0) == "" ? 1 : std::atoi(parts.at(0).c_str());
-							auto two = parts.at(1) == "" ? 99 : std::atoi(parts.at(1).c_str());
-							if (two < one) {
-								OVERDRIVE_THROW(exceptions::BadArgumentFormatException("track-numbers", "range<integer>"));
-							}
-							for (auto track_number = one; track_number <= two; track_number += 1) {
-								track_numbers.insert(track_number);
-							}
-						}
-					}
-					options.track_numbers = track_numbers;
-				}
-			}));
+			vector::append(parsers, get_iso_parsers(options));
 			parsers = parser::sort(parsers);
 			try {
 				parser::parse(arguments, parsers);
@@ -77,38 +42,107 @@ namespace tasks {
 			}
 		}
 
-		auto write_iso(
-			const drive::Drive& drive,
-			const std::vector<disc::TrackInfo>& tracks,
-			const ISOOptions& options
-		) -> void {
-			for (auto track_index = size_t(0); track_index < tracks.size(); track_index += 1) {
-				auto& track = tracks.at(track_index);
-				auto extracted_sectors_vector = archiver::read_track(drive, track, options);
-				auto bad_sector_indices = archiver::get_bad_sector_indices(extracted_sectors_vector, track.first_sector_absolute);
-				archiver::log_bad_sector_indices(drive, track, bad_sector_indices);
-				if (disc::is_data_track(track.type)) {
-					auto user_data_offset = disc::get_user_data_offset(track.type);
-					auto user_data_length = disc::get_user_data_length(track.type);
-					auto path = path::create_path(options.path)
-						.with_extension(std::format(".{:0>2}.iso", track.number))
-						.create_directories();
-					archiver::write_sector_data_to_file(extracted_sectors_vector, path, user_data_offset, user_data_length, false);
-				} else {
-					OVERDRIVE_THROW(exceptions::ExpectedDataTrackException(track.number));
+		class ISOWriterState {
+			public:
+
+			~ISOWriterState(
+			) {
+				this->close();
+			}
+
+			auto close(
+			) -> void {
+				for (auto handle : this->handles) {
+					archiver::close_handle(handle);
 				}
+				this->handles.clear();
 			}
-		}
+
+			std::vector<std::string> paths;
+			std::vector<std::FILE*> handles;
+			std::map<size_t, size_t> handle_indices;
+
+			protected:
+		};
 	}
 	}
 
+	auto get_iso_parsers(
+		ISOOptions& options
+	) -> std::vector<parser::Parser> {
+		auto parsers = std::vector<parser::Parser>();
+		parsers.push_back(parser::Parser({
+			"track-numbers",
+			{},
+			"Specify which track numbers to save.",
+			std::regex("^((?:[1-9]|[1-9][0-9])|(?:(?:[1-9]|[1-9][0-9])?[:](?:[1-9]|[1-9][0-9])?))$"),
+			"range<integer>",
+			false,
+			std::optional<std::string>(),
+			0,
+			99,
+			[&](const std::vector<std::string>& matches) -> void {
+				auto track_numbers = std::set<size_t>();
+				for (auto& match : matches) {
+					auto parts = string::split(match, ":");
+					if (parts.size() == 1) {
+						track_numbers.insert(std::atoi(parts.at(0).c_str()));
+					} else {
+						auto one = parts.at(0) == "" ? 1 : std::atoi(parts.at(0).c_str());
+						auto two = parts.at(1) == "" ? 99 : std::atoi(parts.at(1).c_str());
+						if (two < one) {
+							OVERDRIVE_THROW(exceptions::BadArgumentFormatException("track-numbers", "range<integer>"));
+						}
+						for (auto track_number = one; track_number <= two; track_number += 1) {
+							track_numbers.insert(track_number);
+						}
+					}
+				}
+				options.track_numbers = track_numbers;
+			}
+		}));
+		return parsers;
+	}
+
+	auto create_iso_writer(
+		const disc::DiscInfo& disc_info,
+		const ISOOptions& options
+	) -> ImageWriter {
+		auto tracks = disc::get_disc_tracks(disc_info, options.track_numbers);
+		internal::assert_image_compatibility(tracks);
+		auto state = std::make_shared<internal::ISOWriterState>();
+		for (auto& track : tracks) {
+			auto path = path::create_path(options.path)
+				.with_extension(std::format(".{:0>2}.iso", track.number))
+				.create_directories();
+			state->paths.push_back(path);
+			state->handles.push_back(archiver::open_handle(path));
+			state->handle_indices[track.number] = state->handles.size() - 1;
+			OVERDRIVE_LOG("Saving track sector data to \"{}\"", std::string(path));
+		}
+		auto writer = ImageWriter();
+		writer.tracks = tracks;
+		writer.write_track_sector = [=](const disc::TrackInfo& track, si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+			(void)sector_index;
+			(void)is_readable;
+			auto handle_index = state->handle_indices.at(track.number);
+			auto user_data_offset = disc::get_user_data_offset(track.type);
+			auto user_data_length = disc::get_user_data_length(track.type);
+			archiver::append_sector_data(extracted_sector, state->paths.at(handle_index), user_data_offset, user_data_length, state->handles.at(handle_index), false);
+		};
+		writer.finish = [=]() -> void {
+			state->close();
+		};
+		return writer;
+	}
+
 	auto iso(
 		const std::vector<std::string>& arguments
 	) -> void {
 		auto options = internal::parse_options(arguments);
 		auto detail = options.drive.ends_with(".odi") ? odi::create_detail() : detail::create_detail();
 		auto drive_handle = detail.get_handle(options.drive);
-		auto drive = drive::create_drive(drive_handle, detail.ioctl);
+		auto drive = drive::create_drive(drive_handle, detail);
 		auto drive_info = drive.read_drive_info();
 		drive_info.print();
 		auto disc_info = drive.read_disc_info();
@@ -116,8 +150,12 @@ namespace tasks {
 		if (!options.read_correction) {
 			options.read_correction = drive_info.read_offset_correction;
 		}
-		auto tracks = disc::get_disc_tracks(disc_info, options.track_numbers);
-		internal::assert_image_compatibility(tracks);
-		internal::write_iso(drive, tracks, options);
+		auto writer = create_iso_writer(disc_info, options);
+		auto journal_path = path::create_path(options.path)
+			.with_extension(".journal")
+			.create_directories();
+		auto journal = journal::Journal(journal_path, journal::compute_fingerprint(disc_info, options.read_correction.value_or(0)), options.resume);
+		write_images(drive, journal, nullptr, disc_info, options, { writer });
+		journal.discard();
 	};
 }
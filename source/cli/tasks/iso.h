@@ -1,13 +1,33 @@
 #pragma once
 
+#include <optional>
+#include <set>
 #include <string>
 #include <vector>
 #include "../../lib/overdrive.h"
+#include "image.h"
 
 using namespace overdrive;
 using namespace shared;
 
 namespace tasks {
+	class ISOOptions: public options::Options {
+		public:
+
+		std::optional<std::set<size_t>> track_numbers;
+
+		protected:
+	};
+
+	auto get_iso_parsers(
+		ISOOptions& options
+	) -> std::vector<parser::Parser>;
+
+	auto create_iso_writer(
+		const disc::DiscInfo& disc_info,
+		const ISOOptions& options
+	) -> ImageWriter;
+
 	auto iso(
 		const std::vector<std::string>& arguments
 	) -> void;
@@ -1,19 +1,11 @@
 #include "mds.h"
 
 #include <cstdio>
+#include <memory>
 #include <optional>
 #include <regex>
 
 namespace tasks {
-	class MDSOptions: public options::Options {
-		public:
-
-		bool_t save_audio_subchannels;
-		bool_t save_data_subchannels;
-
-		protected:
-	};
-
 	namespace internal {
 	namespace {
 		auto parse_options(
@@ -21,34 +13,7 @@ namespace tasks {
 		) -> MDSOptions {
 			auto options = MDSOptions();
 			auto parsers = options::get_default_parsers(options);
-			parsers.push_back(parser::Parser({
-				"save-audio-subchannels",
-				{ "save-subchannels" },
-				"Specify whether to save subchannel data for audio tracks.",
-				std::regex("^(true|false)$"),
-				"boolean",
-				false,
-				std::optional<std::string>("false"),
-				1,
-				1,
-				[&](const std::vector<std::string>& matches) -> void {
-					options.save_audio_subchannels = matches.at(0) == "true";
-				}
-			}));
-			parsers.push_back(parser::Parser({
-				"save-data-subchannels",
-				{ "save-subchannels" },
-				"Specify whether to save subchannel data for data tracks.",
-				std::regex("^(true|false)$"),
-				"boolean",
-				false,
-				std::optional<std::string>("false"),
-				1,
-				1,
-				[&](const std::vector<std::string>& matches) -> void {
-					options.save_data_subchannels = matches.at(0) == "true";
-				}
-			}));
+			vector::append(parsers, get_mds_parsers(options));
 			parsers = parser::sort(parsers);
 			try {
 				parser::parse(arguments, parsers);
@@ -65,37 +30,6 @@ namespace tasks {
 			(void)tracks;
 		}
 
-		auto write_mdf(
-			const drive::Drive& drive,
-			const std::vector<disc::TrackInfo>& tracks,
-			const MDSOptions& options
-		) -> std::vector<size_t> {
-			auto result = std::vector<size_t>();
-			auto path = path::create_path(options.path)
-				.with_extension(".mdf")
-				.create_directories();
-			auto handle = archiver::open_handle(path);
-			try {
-				for (auto track_index = size_t(0); track_index < tracks.size(); track_index += 1) {
-					auto& track = tracks.at(track_index);
-					auto extracted_sectors_vector = archiver::read_track(drive, track, options);
-					auto bad_sector_indices = archiver::get_bad_sector_indices(extracted_sectors_vector, track.first_sector_absolute);
-					archiver::log_bad_sector_indices(drive, track, bad_sector_indices);
-					vector::append<size_t>(result, bad_sector_indices);
-					if (disc::is_data_track(track.type)) {
-						archiver::append_sector_data(extracted_sectors_vector, path, 0, cd::SECTOR_LENGTH, handle, options.save_data_subchannels);
-					} else {
-						archiver::append_sector_data(extracted_sectors_vector, path, 0, cd::SECTOR_LENGTH, handle, options.save_audio_subchannels);
-					}
-				}
-			}  catch (...) {
-				archiver::close_handle(handle);
-				throw;
-			}
-			archiver::close_handle(handle);
-			return result;
-		}
-
 		auto write_mds(
 			const disc::DiscInfo& disc,
 			const MDSOptions& options,
@@ -235,7 +169,97 @@ namespace tasks {
 				}
 			}
 		}
+
+		class MDSWriterState {
+			public:
+
+			~MDSWriterState(
+			) {
+				this->close();
+			}
+
+			auto close(
+			) -> void {
+				if (this->handle != nullptr) {
+					archiver::close_handle(this->handle);
+					this->handle = nullptr;
+				}
+			}
+
+			std::string path;
+			std::FILE* handle;
+			std::vector<size_t> bad_sector_indices;
+
+			protected:
+		};
+	}
+	}
+
+	auto get_mds_parsers(
+		MDSOptions& options
+	) -> std::vector<parser::Parser> {
+		auto parsers = std::vector<parser::Parser>();
+		parsers.push_back(parser::Parser({
+			"save-audio-subchannels",
+			{ "save-subchannels" },
+			"Specify whether to save subchannel data for audio tracks.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("false"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.save_audio_subchannels = matches.at(0) == "true";
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"save-data-subchannels",
+			{ "save-subchannels" },
+			"Specify whether to save subchannel data for data tracks.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("false"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.save_data_subchannels = matches.at(0) == "true";
+			}
+		}));
+		return parsers;
 	}
+
+	auto create_mds_writer(
+		const disc::DiscInfo& disc_info,
+		const MDSOptions& options
+	) -> ImageWriter {
+		auto tracks = disc::get_disc_tracks(disc_info);
+		internal::assert_image_compatibility(tracks);
+		auto path = path::create_path(options.path)
+			.with_extension(".mdf")
+			.create_directories();
+		auto state = std::make_shared<internal::MDSWriterState>();
+		state->path = path;
+		state->handle = archiver::open_handle(path);
+		OVERDRIVE_LOG("Saving track sector data to \"{}\"", std::string(path));
+		auto writer = ImageWriter();
+		writer.tracks = tracks;
+		writer.write_track_sector = [=](const disc::TrackInfo& track, si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+			(void)sector_index;
+			(void)is_readable;
+			auto write_subchannels = disc::is_data_track(track.type) ? options.save_data_subchannels : options.save_audio_subchannels;
+			archiver::append_sector_data(extracted_sector, state->path, 0, cd::SECTOR_LENGTH, state->handle, write_subchannels);
+		};
+		writer.finish_track = [=](const disc::TrackInfo& track, const std::vector<size_t>& bad_sector_indices) -> void {
+			(void)track;
+			vector::append<size_t>(state->bad_sector_indices, bad_sector_indices);
+		};
+		writer.finish = [=]() -> void {
+			state->close();
+			internal::write_mds(disc_info, options, state->bad_sector_indices);
+		};
+		return writer;
 	}
 
 	auto mds(
@@ -244,7 +268,7 @@ namespace tasks {
 		auto options = internal::parse_options(arguments);
 		auto detail = options.drive.ends_with(".odi") ? odi::create_detail() : detail::create_detail();
 		auto drive_handle = detail.get_handle(options.drive);
-		auto drive = drive::create_drive(drive_handle, detail.ioctl);
+		auto drive = drive::create_drive(drive_handle, detail);
 		auto drive_info = drive.read_drive_info();
 		drive_info.print();
 		auto disc_info = drive.read_disc_info();
@@ -252,9 +276,16 @@ namespace tasks {
 		if (!options.read_correction) {
 			options.read_correction = drive_info.read_offset_correction;
 		}
-		auto tracks = disc::get_disc_tracks(disc_info);
-		internal::assert_image_compatibility(tracks);
-		auto bad_sector_indices = internal::write_mdf(drive, tracks, options);
-		internal::write_mds(disc_info, options, bad_sector_indices);
+		auto accuraterip_lookup = options.accuraterip_database ? std::optional<accuraterip::Lookup>(accuraterip::create_lookup(disc_info, options.accuraterip_database.value())) : std::optional<accuraterip::Lookup>();
+		if (!options.read_correction && accuraterip_lookup) {
+			options.read_correction = archiver::detect_read_offset_correction(drive, disc_info, accuraterip_lookup.value(), options);
+		}
+		auto writer = create_mds_writer(disc_info, options);
+		auto journal_path = path::create_path(options.path)
+			.with_extension(".journal")
+			.create_directories();
+		auto journal = journal::Journal(journal_path, journal::compute_fingerprint(disc_info, options.read_correction.value_or(0)), options.resume);
+		write_images(drive, journal, accuraterip_lookup ? &accuraterip_lookup.value() : nullptr, disc_info, options, { writer });
+		journal.discard();
 	};
 }
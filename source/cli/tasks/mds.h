@@ -3,11 +3,30 @@
 #include <string>
 #include <vector>
 #include "../../lib/overdrive.h"
+#include "image.h"
 
 using namespace overdrive;
 using namespace shared;
 
 namespace tasks {
+	class MDSOptions: public options::Options {
+		public:
+
+		bool_t save_audio_subchannels;
+		bool_t save_data_subchannels;
+
+		protected:
+	};
+
+	auto get_mds_parsers(
+		MDSOptions& options
+	) -> std::vector<parser::Parser>;
+
+	auto create_mds_writer(
+		const disc::DiscInfo& disc_info,
+		const MDSOptions& options
+	) -> ImageWriter;
+
 	auto mds(
 		const std::vector<std::string>& arguments
 	) -> void;
@@ -1,37 +1,28 @@
 #include "odi.h"
 
-#include <set>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <thread>
 
 namespace tasks {
-	class ODIptions: public options::Options {
-		public:
-
-		bool_t compress;
-
-		protected:
-	};
-
 	namespace internal {
 	namespace {
+		const auto MAX_QUEUED_SECTORS = size_t(256);
+		const auto MAX_BATCHED_SECTORS = size_t(64);
+
 		auto parse_options(
 			const std::vector<std::string>& arguments
 		) -> ODIptions {
 			auto options = ODIptions();
 			auto parsers = options::get_default_parsers(options);
-			parsers.push_back(parser::Parser({
-				"compress",
-				{},
-				"Specify whether to compress extracted data.",
-				std::regex("^(true|false)$"),
-				"boolean",
-				false,
-				std::optional<std::string>("true"),
-				1,
-				1,
-				[&](const std::vector<std::string>& matches) -> void {
-					options.compress = matches.at(0) == "true";
-				}
-			}));
+			vector::append(parsers, get_odi_parsers(options));
 			parsers = parser::sort(parsers);
 			try {
 				parser::parse(arguments, parsers);
@@ -42,197 +33,465 @@ namespace tasks {
 			}
 		}
 
-		auto compress_sector(
-			archiver::ExtractedSector& extracted_sector,
-			bool_t is_readable,
-			odi::SectorDataCompressionMethod::type sector_data_method,
-			odi::SubchannelsDataCompressionMethod::type subchannels_method,
-			const ODIptions& options
-		) -> odi::SectorTableEntry {
-			auto& subchannels = *reinterpret_cast<cd::Subchannels*>(&extracted_sector.subchannels_data);
-			subchannels = cd::deinterleave_subchannels(subchannels);
-			auto sector_table_entry = odi::SectorTableEntry();
-			sector_table_entry.readability = is_readable ? odi::Readability::READABLE : odi::Readability::UNREADABLE;
-			sector_table_entry.sector_data.compressed_byte_count = cd::SECTOR_LENGTH;
-			sector_table_entry.sector_data.compression_method = odi::SectorDataCompressionMethod::NONE;
-			sector_table_entry.subchannels_data.compressed_byte_count = cd::SUBCHANNELS_LENGTH;
-			sector_table_entry.subchannels_data.compression_method = odi::SubchannelsDataCompressionMethod::NONE;
-			if (options.compress) {
-				try {
-					sector_table_entry.sector_data.compressed_byte_count = odi::compress_sector_data(extracted_sector.sector_data, sector_data_method);
-					sector_table_entry.sector_data.compression_method = sector_data_method;
-				} catch (const exceptions::CompressedSizeExceededUncompressedSizeException& e) {}
-				try {
-					sector_table_entry.subchannels_data.compressed_byte_count = odi::compress_subchannels_data(extracted_sector.subchannels_data, subchannels_method);
-					sector_table_entry.subchannels_data.compression_method = subchannels_method;
-				} catch (const exceptions::CompressedSizeExceededUncompressedSizeException& e) {}
-			}
-			return sector_table_entry;
-		}
-
-		auto save_sector_range(
-			const drive::Drive& drive,
-			si_t first_sector,
-			si_t last_sector,
-			const ODIptions& options,
+		auto write_compressed_sector(
+			const archiver::ExtractedSector& compressed_sector,
+			odi::SectorTableEntry& sector_table_entry,
 			std::FILE* handle,
 			const std::string& path
-		) -> std::vector<odi::SectorTableEntry> {
-			auto extracted_sectors_vector = archiver::read_absolute_sector_range(
-				drive,
-				first_sector,
-				last_sector,
-				options.min_data_passes,
-				options.max_data_passes,
-				options.max_data_retries,
-				options.min_data_copies,
-				options.max_data_copies
-			);
-			auto bad_sector_indices = archiver::get_bad_sector_indices(extracted_sectors_vector, first_sector);
-			auto bad_sector_indices_set = std::set<size_t>(bad_sector_indices.begin(), bad_sector_indices.end());
-			OVERDRIVE_LOG("Sector range between {} and {} has {} bad sectors!", first_sector, last_sector, bad_sector_indices.size());
-			auto sector_table_entries = std::vector<odi::SectorTableEntry>(last_sector - first_sector);
-			for (auto sector_index = size_t(0); sector_index < extracted_sectors_vector.size(); sector_index += 1) {
-				auto is_readable = !bad_sector_indices_set.contains(first_sector + sector_index);
-				auto& extracted_sectors = extracted_sectors_vector.at(sector_index);
-				auto& extracted_sector = extracted_sectors.at(0);
-				auto& sector_table_entry = sector_table_entries.at(sector_index);
-				sector_table_entry = compress_sector(extracted_sector, is_readable, odi::SectorDataCompressionMethod::RUN_LENGTH_ENCODING, odi::SubchannelsDataCompressionMethod::RUN_LENGTH_ENCODING, options);
-				sector_table_entry.compressed_data_absolute_offset = std::ftell(handle);
-				if (std::fwrite(extracted_sector.sector_data, sector_table_entry.sector_data.compressed_byte_count, 1, handle) != 1) {
-					OVERDRIVE_THROW(exceptions::IOWriteException(path));
+		) -> void {
+			sector_table_entry.compressed_data_absolute_offset = std::ftell(handle);
+			if (std::fwrite(compressed_sector.sector_data, sector_table_entry.sector_data.compressed_byte_count, 1, handle) != 1) {
+				OVERDRIVE_THROW(exceptions::IOWriteException(path));
+			}
+			if (std::fwrite(compressed_sector.subchannels_data, sector_table_entry.subchannels_data.compressed_byte_count, 1, handle) != 1) {
+				OVERDRIVE_THROW(exceptions::IOWriteException(path));
+			}
+		}
+
+		class PipelineSector {
+			public:
+
+			size_t sequence_index;
+			std::optional<disc::TrackInfo> track;
+			archiver::ExtractedSector sector;
+			bool_t is_readable;
+			odi::SectorDataCompressionMethod::type sector_data_method;
+			odi::SubchannelsDataCompressionMethod::type subchannels_method;
+			odi::SectorTableEntry sector_table_entry;
+
+			protected:
+		};
+
+		auto compress_sectors(
+			std::vector<PipelineSector>& pipeline_sectors,
+			const ODIptions& options
+		) -> void {
+			for (auto& pipeline_sector : pipeline_sectors) {
+				auto& sector_table_entry = pipeline_sector.sector_table_entry;
+				sector_table_entry.readability = pipeline_sector.is_readable ? odi::Readability::READABLE : odi::Readability::UNREADABLE;
+				sector_table_entry.sector_data.compressed_byte_count = cd::SECTOR_LENGTH;
+				sector_table_entry.sector_data.compression_method = odi::SectorDataCompressionMethod::NONE;
+				sector_table_entry.subchannels_data.compressed_byte_count = cd::SUBCHANNELS_LENGTH;
+				sector_table_entry.subchannels_data.compression_method = odi::SubchannelsDataCompressionMethod::NONE;
+			}
+			if (!options.compress) {
+				return;
+			}
+			auto sector_data = std::vector<pointer<array<cd::SECTOR_LENGTH, byte_t>>>();
+			auto sector_data_methods = std::vector<odi::SectorDataCompressionMethod::type>();
+			for (auto& pipeline_sector : pipeline_sectors) {
+				sector_data.push_back(&pipeline_sector.sector.sector_data);
+				sector_data_methods.push_back(pipeline_sector.sector_data_method);
+			}
+			auto compressed_byte_counts = odi::compress_sector_data_batch(sector_data, sector_data_methods);
+			for (auto sector_index = size_t(0); sector_index < pipeline_sectors.size(); sector_index += 1) {
+				auto& pipeline_sector = pipeline_sectors.at(sector_index);
+				auto& sector_table_entry = pipeline_sector.sector_table_entry;
+				if (compressed_byte_counts.at(sector_index)) {
+					sector_table_entry.sector_data.compressed_byte_count = compressed_byte_counts.at(sector_index).value();
+					sector_table_entry.sector_data.compression_method = pipeline_sector.sector_data_method;
 				}
-				if (std::fwrite(extracted_sector.subchannels_data, sector_table_entry.subchannels_data.compressed_byte_count, 1, handle) != 1) {
-					OVERDRIVE_THROW(exceptions::IOWriteException(path));
+				auto compressed_byte_count = odi::compress_subchannels_data(pipeline_sector.sector.subchannels_data, pipeline_sector.subchannels_method);
+				if (compressed_byte_count) {
+					sector_table_entry.subchannels_data.compressed_byte_count = compressed_byte_count.value();
+					sector_table_entry.subchannels_data.compression_method = pipeline_sector.subchannels_method;
 				}
 			}
-			return sector_table_entries;
 		}
 
-		auto write_odi(
-			const drive::Drive& drive,
-			const disc::DiscInfo& disc,
+		// Extracted sectors pass through a subchannel stage and a compression stage before being written in extraction order.
+		class ODIWriterState {
+			public:
+
+			ODIWriterState(
+				const ODIptions& options
+			);
+
+			~ODIWriterState(
+			);
+
+			auto start(
+			) -> void;
+
+			auto submit(
+				PipelineSector&& pipeline_sector
+			) -> void;
+
+			auto drain(
+			) -> void;
+
+			auto close(
+			) -> void;
+
+			std::string path;
+			std::FILE* handle;
+			odi::FileHeader file_header;
+			std::vector<odi::SectorTableEntry> sector_table_entries;
+
+			protected:
+
+			auto fail(
+			) -> void;
+
+			auto run_subchannels_worker(
+			) -> void;
+
+			auto run_compression_worker(
+			) -> void;
+
+			auto run_write_worker(
+			) -> void;
+
+			ODIptions options;
+			size_t next_sequence_index;
+			pipeline::Queue<PipelineSector> subchannels_queue;
+			pipeline::Queue<PipelineSector> compression_queue;
+			pipeline::Queue<PipelineSector> write_queue;
+			std::vector<std::thread> threads;
+			std::mutex mutex;
+			std::exception_ptr exception;
+			std::map<size_t, size_t> compressed_byte_counts;
+			std::map<size_t, size_t> written_sector_counts;
+		};
+
+		ODIWriterState::ODIWriterState(
 			const ODIptions& options
+		): subchannels_queue(MAX_QUEUED_SECTORS, 1), compression_queue(MAX_QUEUED_SECTORS, options.subchannels_workers), write_queue(MAX_QUEUED_SECTORS, 1) {
+			this->handle = nullptr;
+			this->file_header = odi::FileHeader();
+			this->options = options;
+			this->next_sequence_index = 0;
+		}
+
+		ODIWriterState::~ODIWriterState(
+		) {
+			this->subchannels_queue.cancel();
+			this->compression_queue.cancel();
+			this->write_queue.cancel();
+			for (auto& thread : this->threads) {
+				thread.join();
+			}
+			this->close();
+		}
+
+		auto ODIWriterState::start(
+		) -> void {
+			for (auto worker_index = size_t(0); worker_index < this->options.subchannels_workers; worker_index += 1) {
+				this->threads.push_back(std::thread([this]() -> void {
+					this->run_subchannels_worker();
+				}));
+			}
+			this->threads.push_back(std::thread([this]() -> void {
+				this->run_compression_worker();
+			}));
+			this->threads.push_back(std::thread([this]() -> void {
+				this->run_write_worker();
+			}));
+		}
+
+		auto ODIWriterState::submit(
+			PipelineSector&& pipeline_sector
+		) -> void {
+			pipeline_sector.sequence_index = this->next_sequence_index;
+			this->next_sequence_index += 1;
+			if (!this->subchannels_queue.push(std::move(pipeline_sector))) {
+				auto lock = std::unique_lock<std::mutex>(this->mutex);
+				std::rethrow_exception(this->exception);
+			}
+		}
+
+		auto ODIWriterState::drain(
+		) -> void {
+			this->subchannels_queue.close();
+			for (auto& thread : this->threads) {
+				thread.join();
+			}
+			this->threads.clear();
+			if (this->exception) {
+				std::rethrow_exception(this->exception);
+			}
+		}
+
+		auto ODIWriterState::close(
+		) -> void {
+			if (this->handle != nullptr) {
+				archiver::close_handle(this->handle);
+				this->handle = nullptr;
+			}
+		}
+
+		auto ODIWriterState::fail(
+		) -> void {
+			{
+				auto lock = std::unique_lock<std::mutex>(this->mutex);
+				if (!this->exception) {
+					this->exception = std::current_exception();
+				}
+			}
+			this->subchannels_queue.cancel();
+			this->compression_queue.cancel();
+			this->write_queue.cancel();
+		}
+
+		auto ODIWriterState::run_subchannels_worker(
 		) -> void {
-			auto points = disc::get_disc_points(disc);
-			auto path = path::create_path(options.path)
-				.with_extension(".odi")
-				.create_directories();
-			auto handle = archiver::open_handle(path);
 			try {
-				auto file_header = odi::FileHeader();
-				file_header.header_length = sizeof(odi::FileHeader);
-				file_header.sector_table_header_absolute_offset = 0;
-				file_header.point_table_header_absolute_offset = 0;
-				if (std::fwrite(&file_header, sizeof(file_header), 1, handle) != 1) {
-					OVERDRIVE_THROW(exceptions::IOWriteException(path));
+				while (auto pipeline_sector = this->subchannels_queue.pop()) {
+					auto& subchannels = *reinterpret_cast<cd::Subchannels*>(&pipeline_sector->sector.subchannels_data);
+					subchannels = cd::deinterleave_subchannels(subchannels);
+					if (!this->compression_queue.push(std::move(pipeline_sector.value()))) {
+						break;
+					}
 				}
-				auto sector_table_entries = std::vector<odi::SectorTableEntry>();
-				auto absolute_sector_offset = 0 - si_t(disc.sessions.front().lead_in_length_sectors);
-				for (auto session_index = size_t(0); session_index < disc.sessions.size(); session_index += 1) {
-					auto& session = disc.sessions.at(session_index);
-					auto lead_in_sector_table_entries = save_sector_range(drive, absolute_sector_offset, absolute_sector_offset + session.lead_in_length_sectors, options, handle, path);
-					vector::append(sector_table_entries, lead_in_sector_table_entries);
-					absolute_sector_offset += session.lead_in_length_sectors;
-					auto pregap_sector_table_entries = save_sector_range(drive, absolute_sector_offset, absolute_sector_offset + session.pregap_sectors, options, handle, path);
-					vector::append(sector_table_entries, pregap_sector_table_entries);
-					absolute_sector_offset += session.pregap_sectors;
-					for (auto track_index = size_t(0); track_index < session.tracks.size(); track_index += 1) {
-						auto& track = session.tracks.at(track_index);
-						auto extracted_sectors_vector = archiver::read_track(drive, track, options);
-						auto bad_sector_indices = archiver::get_bad_sector_indices(extracted_sectors_vector, track.first_sector_absolute);
-						auto bad_sector_indices_set = std::set<size_t>(bad_sector_indices.begin(), bad_sector_indices.end());
-						archiver::log_bad_sector_indices(drive, track, bad_sector_indices);
-						auto compressed_byte_count = size_t(0);
-						auto track_sector_table_entries = std::vector<odi::SectorTableEntry>(track.length_sectors);
-						for (auto sector_index = size_t(0); sector_index < extracted_sectors_vector.size(); sector_index += 1) {
-							auto is_readable = !bad_sector_indices_set.contains(track.first_sector_absolute + sector_index);
-							auto& extracted_sectors = extracted_sectors_vector.at(sector_index);
-							auto& extracted_sector = extracted_sectors.at(0);
-							auto& sector_table_entry = track_sector_table_entries.at(sector_index);
-							auto sector_data_method = track.type == disc::TrackType::AUDIO_2_CHANNELS ? odi::SectorDataCompressionMethod::LOSSLESS_STEREO_AUDIO : odi::SectorDataCompressionMethod::RUN_LENGTH_ENCODING;
-							auto subchannels_data_method = odi::SubchannelsDataCompressionMethod::RUN_LENGTH_ENCODING;
-							sector_table_entry = compress_sector(extracted_sector, is_readable, sector_data_method, subchannels_data_method, options);
+			} catch (...) {
+				this->fail();
+			}
+			this->compression_queue.close();
+		}
+
+		auto ODIWriterState::run_compression_worker(
+		) -> void {
+			try {
+				while (auto pipeline_sector = this->compression_queue.pop()) {
+					// Sectors already queued are compressed together in order to keep every thread in the pool busy.
+					auto pipeline_sectors = std::vector<PipelineSector>();
+					pipeline_sectors.push_back(std::move(pipeline_sector.value()));
+					while (pipeline_sectors.size() < MAX_BATCHED_SECTORS) {
+						auto next_pipeline_sector = this->compression_queue.try_pop();
+						if (!next_pipeline_sector) {
+							break;
 						}
-						for (auto sector_index = size_t(0); sector_index < extracted_sectors_vector.size(); sector_index += 1) {
-							auto& extracted_sectors = extracted_sectors_vector.at(sector_index);
-							auto& extracted_sector = extracted_sectors.at(0);
-							auto& sector_table_entry = track_sector_table_entries.at(sector_index);
-							sector_table_entry.compressed_data_absolute_offset = std::ftell(handle);
-							if (std::fwrite(extracted_sector.sector_data, sector_table_entry.sector_data.compressed_byte_count, 1, handle) != 1) {
-								OVERDRIVE_THROW(exceptions::IOWriteException(path));
-							}
-							if (std::fwrite(extracted_sector.subchannels_data, sector_table_entry.subchannels_data.compressed_byte_count, 1, handle) != 1) {
-								OVERDRIVE_THROW(exceptions::IOWriteException(path));
-							}
-							compressed_byte_count += sector_table_entry.sector_data.compressed_byte_count;
+						pipeline_sectors.push_back(std::move(next_pipeline_sector.value()));
+					}
+					compress_sectors(pipeline_sectors, this->options);
+					auto cancelled = false;
+					for (auto& compressed_pipeline_sector : pipeline_sectors) {
+						if (!this->write_queue.push(std::move(compressed_pipeline_sector))) {
+							cancelled = true;
+							break;
 						}
-						vector::append(sector_table_entries, track_sector_table_entries);
-						absolute_sector_offset += track.length_sectors;
-						auto compression_ratio = float(compressed_byte_count) / (extracted_sectors_vector.size() * cd::SECTOR_LENGTH);
-						OVERDRIVE_LOG("Saved track {} with a compression ratio of {:.2f}", track.number, compression_ratio);
 					}
-					auto lead_out_sector_table_entries = save_sector_range(drive, absolute_sector_offset, absolute_sector_offset + session.lead_out_length_sectors, options, handle, path);
-					vector::append(sector_table_entries, lead_out_sector_table_entries);
-					absolute_sector_offset += session.lead_out_length_sectors;
-				}
-				auto point_table_entries = std::vector<odi::PointTableEntry>();
-				for (auto point_index = size_t(0); point_index < points.size(); point_index += 1) {
-					auto& point = points.at(point_index);
-					auto point_table_entry = odi::PointTableEntry();
-					*reinterpret_cast<cdb::ReadTOCResponseFullTOCEntry*>(&point_table_entry.descriptor) = point.entry;
-					point_table_entries.push_back(point_table_entry);
-				}
-				std::fseek(handle, idiv::ceil(std::ftell(handle), 16) * 16, SEEK_SET);
-				auto sector_table_header = odi::SectorTableHeader();
-				sector_table_header.header_length = sizeof(odi::SectorTableHeader);
-				sector_table_header.entry_length = sizeof(odi::SectorTableEntry);
-				sector_table_header.entry_count = sector_table_entries.size();
-				file_header.sector_table_header_absolute_offset = std::ftell(handle);
-				if (std::fwrite(&sector_table_header, sizeof(sector_table_header), 1, handle) != 1) {
-					OVERDRIVE_THROW(exceptions::IOWriteException(path));
+					if (cancelled) {
+						break;
+					}
 				}
-				for (auto sector_table_index = size_t(0); sector_table_index < sector_table_header.entry_count; sector_table_index += 1) {
-					auto& sector_table_entry = sector_table_entries.at(sector_table_index);
-					if (std::fwrite(&sector_table_entry, sizeof(sector_table_entry), 1, handle) != 1) {
-						OVERDRIVE_THROW(exceptions::IOWriteException(path));
+			} catch (...) {
+				this->fail();
+			}
+			this->write_queue.close();
+		}
+
+		auto ODIWriterState::run_write_worker(
+		) -> void {
+			try {
+				// Sectors are compressed out of order and must be buffered until all preceding sectors have been written.
+				auto pending_sectors = std::map<size_t, PipelineSector>();
+				auto next_sequence_index = size_t(0);
+				while (auto pipeline_sector = this->write_queue.pop()) {
+					auto sequence_index = pipeline_sector->sequence_index;
+					pending_sectors.emplace(sequence_index, std::move(pipeline_sector.value()));
+					while (pending_sectors.size() > 0 && pending_sectors.begin()->first == next_sequence_index) {
+						auto& pending_sector = pending_sectors.begin()->second;
+						write_compressed_sector(pending_sector.sector, pending_sector.sector_table_entry, this->handle, this->path);
+						this->sector_table_entries.push_back(pending_sector.sector_table_entry);
+						if (pending_sector.track) {
+							auto& track = pending_sector.track.value();
+							this->compressed_byte_counts[track.number] += pending_sector.sector_table_entry.sector_data.compressed_byte_count;
+							this->written_sector_counts[track.number] += 1;
+							if (this->written_sector_counts[track.number] == track.length_sectors) {
+								auto compression_ratio = float(this->compressed_byte_counts[track.number]) / (track.length_sectors * cd::SECTOR_LENGTH);
+								OVERDRIVE_LOG("Saved track {} with a compression ratio of {:.2f}", track.number, compression_ratio);
+							}
+						}
+						pending_sectors.erase(pending_sectors.begin());
+						next_sequence_index += 1;
 					}
 				}
-				std::fseek(handle, idiv::ceil(std::ftell(handle), 16) * 16, SEEK_SET);
-				auto point_table_header = odi::PointTableHeader();
-				point_table_header.header_length = sizeof(odi::PointTableHeader);
-				point_table_header.entry_length = sizeof(odi::PointTableEntry);
-				point_table_header.entry_count = point_table_entries.size();
-				file_header.point_table_header_absolute_offset = std::ftell(handle);
-				if (std::fwrite(&point_table_header, sizeof(point_table_header), 1, handle) != 1) {
+			} catch (...) {
+				this->fail();
+			}
+		}
+
+		auto write_tables(
+			const disc::DiscInfo& disc,
+			ODIWriterState& state
+		) -> void {
+			auto& path = state.path;
+			auto& handle = state.handle;
+			auto& file_header = state.file_header;
+			auto& sector_table_entries = state.sector_table_entries;
+			auto points = disc::get_disc_points(disc);
+			auto point_table_entries = std::vector<odi::PointTableEntry>();
+			for (auto point_index = size_t(0); point_index < points.size(); point_index += 1) {
+				auto& point = points.at(point_index);
+				auto point_table_entry = odi::PointTableEntry();
+				*reinterpret_cast<cdb::ReadTOCResponseFullTOCEntry*>(&point_table_entry.descriptor) = point.entry;
+				point_table_entries.push_back(point_table_entry);
+			}
+			std::fseek(handle, idiv::ceil(std::ftell(handle), 16) * 16, SEEK_SET);
+			auto sector_table_header = odi::SectorTableHeader();
+			sector_table_header.header_length = sizeof(odi::SectorTableHeader);
+			sector_table_header.entry_length = sizeof(odi::SectorTableEntry);
+			sector_table_header.entry_count = sector_table_entries.size();
+			file_header.sector_table_header_absolute_offset = std::ftell(handle);
+			if (std::fwrite(&sector_table_header, sizeof(sector_table_header), 1, handle) != 1) {
+				OVERDRIVE_THROW(exceptions::IOWriteException(path));
+			}
+			for (auto sector_table_index = size_t(0); sector_table_index < sector_table_header.entry_count; sector_table_index += 1) {
+				auto& sector_table_entry = sector_table_entries.at(sector_table_index);
+				if (std::fwrite(&sector_table_entry, sizeof(sector_table_entry), 1, handle) != 1) {
 					OVERDRIVE_THROW(exceptions::IOWriteException(path));
 				}
-				for (auto point_table_index = size_t(0); point_table_index < point_table_header.entry_count; point_table_index += 1) {
-					auto& point_table_entry = point_table_entries.at(point_table_index);
-					if (std::fwrite(&point_table_entry, sizeof(point_table_entry), 1, handle) != 1) {
-						OVERDRIVE_THROW(exceptions::IOWriteException(path));
-					}
-				}
-				std::fseek(handle, 0, SEEK_SET);
-				if (std::fwrite(&file_header, sizeof(file_header), 1, handle) != 1) {
+			}
+			std::fseek(handle, idiv::ceil(std::ftell(handle), 16) * 16, SEEK_SET);
+			auto point_table_header = odi::PointTableHeader();
+			point_table_header.header_length = sizeof(odi::PointTableHeader);
+			point_table_header.entry_length = sizeof(odi::PointTableEntry);
+			point_table_header.entry_count = point_table_entries.size();
+			file_header.point_table_header_absolute_offset = std::ftell(handle);
+			if (std::fwrite(&point_table_header, sizeof(point_table_header), 1, handle) != 1) {
+				OVERDRIVE_THROW(exceptions::IOWriteException(path));
+			}
+			for (auto point_table_index = size_t(0); point_table_index < point_table_header.entry_count; point_table_index += 1) {
+				auto& point_table_entry = point_table_entries.at(point_table_index);
+				if (std::fwrite(&point_table_entry, sizeof(point_table_entry), 1, handle) != 1) {
 					OVERDRIVE_THROW(exceptions::IOWriteException(path));
 				}
-			}  catch (...) {
-				archiver::close_handle(handle);
-				throw;
 			}
-			archiver::close_handle(handle);
+			// The image is marked with the lowest minor version supporting every compression method used.
+			file_header.minor_version = 0;
+			for (auto& sector_table_entry : sector_table_entries) {
+				auto minor_version = odi::SectorDataCompressionMethod::get_minor_version(sector_table_entry.sector_data.compression_method);
+				file_header.minor_version = std::max<ui08_t>(file_header.minor_version, minor_version);
+			}
+			std::fseek(handle, 0, SEEK_SET);
+			if (std::fwrite(&file_header, sizeof(file_header), 1, handle) != 1) {
+				OVERDRIVE_THROW(exceptions::IOWriteException(path));
+			}
 		}
 	}
 	}
 
+	auto get_odi_parsers(
+		ODIptions& options
+	) -> std::vector<parser::Parser> {
+		auto parsers = std::vector<parser::Parser>();
+		parsers.push_back(parser::Parser({
+			"compress",
+			{},
+			"Specify whether to compress extracted data.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("true"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.compress = matches.at(0) == "true";
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"lpc",
+			{},
+			"Specify whether to compress audio sectors using linear prediction.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("true"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.lpc = matches.at(0) == "true";
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"subchannels-workers",
+			{},
+			"Specify the number of workers preparing subchannel data for compression.",
+			std::regex("^([1-9]|[1-9][0-9])$"),
+			"integer",
+			false,
+			std::optional<std::string>("1"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.subchannels_workers = std::atoi(matches.at(0).c_str());
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"threads",
+			{},
+			"Specify the number of threads used for compressing sector data.",
+			std::regex("^([1-9]|[1-9][0-9])$"),
+			"integer",
+			false,
+			std::optional<std::string>(std::to_string(std::clamp<size_t>(std::thread::hardware_concurrency(), 1, 99))),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.threads = std::atoi(matches.at(0).c_str());
+			}
+		}));
+		return parsers;
+	}
+
+	auto create_odi_writer(
+		const disc::DiscInfo& disc_info,
+		const ODIptions& options
+	) -> ImageWriter {
+		auto path = path::create_path(options.path)
+			.with_extension(".odi")
+			.create_directories();
+		pool::set_worker_count(options.threads);
+		auto state = std::make_shared<internal::ODIWriterState>(options);
+		state->path = path;
+		state->handle = archiver::open_handle(path);
+		state->file_header.header_length = sizeof(odi::FileHeader);
+		state->file_header.sector_table_header_absolute_offset = 0;
+		state->file_header.point_table_header_absolute_offset = 0;
+		if (std::fwrite(&state->file_header, sizeof(state->file_header), 1, state->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOWriteException(path));
+		}
+		state->start();
+		auto writer = ImageWriter();
+		writer.tracks = disc::get_disc_tracks(disc_info);
+		writer.write_session_sector = [=](si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+			(void)sector_index;
+			auto pipeline_sector = internal::PipelineSector();
+			pipeline_sector.sector = extracted_sector;
+			pipeline_sector.is_readable = is_readable;
+			pipeline_sector.sector_data_method = odi::SectorDataCompressionMethod::RUN_LENGTH_ENCODING;
+			pipeline_sector.subchannels_method = odi::SubchannelsDataCompressionMethod::RUN_LENGTH_ENCODING;
+			state->submit(std::move(pipeline_sector));
+		};
+		writer.write_track_sector = [=](const disc::TrackInfo& track, si_t sector_index, const archiver::ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+			(void)sector_index;
+			auto pipeline_sector = internal::PipelineSector();
+			pipeline_sector.track = track;
+			pipeline_sector.sector = extracted_sector;
+			pipeline_sector.is_readable = is_readable;
+			pipeline_sector.sector_data_method = odi::SectorDataCompressionMethod::RUN_LENGTH_ENCODING;
+			if (track.type == disc::TrackType::AUDIO_2_CHANNELS) {
+				pipeline_sector.sector_data_method = options.lpc ? odi::SectorDataCompressionMethod::LOSSLESS_STEREO_AUDIO_LPC : odi::SectorDataCompressionMethod::LOSSLESS_STEREO_AUDIO;
+			}
+			pipeline_sector.subchannels_method = odi::SubchannelsDataCompressionMethod::RUN_LENGTH_ENCODING;
+			state->submit(std::move(pipeline_sector));
+		};
+		writer.finish = [=]() -> void {
+			state->drain();
+			internal::write_tables(disc_info, *state);
+			state->close();
+		};
+		return writer;
+	}
+
 	auto odi(
 		const std::vector<std::string>& arguments
 	) -> void {
 		auto options = internal::parse_options(arguments);
 		auto detail = options.drive.ends_with(".odi") ? odi::create_detail() : detail::create_detail();
 		auto drive_handle = detail.get_handle(options.drive);
-		auto drive = drive::create_drive(drive_handle, detail.ioctl);
+		auto drive = drive::create_drive(drive_handle, detail);
 		auto drive_info = drive.read_drive_info();
 		drive_info.print();
 		auto disc_info = drive.read_disc_info();
@@ -240,6 +499,16 @@ namespace tasks {
 		if (!options.read_correction) {
 			options.read_correction = drive_info.read_offset_correction;
 		}
-		internal::write_odi(drive, disc_info, options);
+		auto accuraterip_lookup = options.accuraterip_database ? std::optional<accuraterip::Lookup>(accuraterip::create_lookup(disc_info, options.accuraterip_database.value())) : std::optional<accuraterip::Lookup>();
+		if (!options.read_correction && accuraterip_lookup) {
+			options.read_correction = archiver::detect_read_offset_correction(drive, disc_info, accuraterip_lookup.value(), options);
+		}
+		auto writer = create_odi_writer(disc_info, options);
+		auto journal_path = path::create_path(options.path)
+			.with_extension(".journal")
+			.create_directories();
+		auto journal = journal::Journal(journal_path, journal::compute_fingerprint(disc_info, options.read_correction.value_or(0)), options.resume);
+		write_images(drive, journal, accuraterip_lookup ? &accuraterip_lookup.value() : nullptr, disc_info, options, { writer });
+		journal.discard();
 	};
 }
@@ -3,11 +3,32 @@
 #include <string>
 #include <vector>
 #include "../../lib/overdrive.h"
+#include "image.h"
 
 using namespace overdrive;
 using namespace shared;
 
 namespace tasks {
+	class ODIptions: public options::Options {
+		public:
+
+		bool_t compress;
+		bool_t lpc;
+		size_t subchannels_workers;
+		size_t threads;
+
+		protected:
+	};
+
+	auto get_odi_parsers(
+		ODIptions& options
+	) -> std::vector<parser::Parser>;
+
+	auto create_odi_writer(
+		const disc::DiscInfo& disc_info,
+		const ODIptions& options
+	) -> ImageWriter;
+
 	auto odi(
 		const std::vector<std::string>& arguments
 	) -> void;
@@ -1,6 +1,12 @@
 #include "accuraterip.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstdlib>
+#include <format>
+#include "cd.h"
+#include "cdda.h"
+#include "exceptions.h"
 #include "string.h"
 
 auto CSV(
@@ -4548,6 +4554,40 @@ namespace accuraterip {
 			}
 			return read_offset_correction_values;
 		}
+
+		auto get_digit_sum(
+			size_t value
+		) -> size_t {
+			auto digit_sum = size_t(0);
+			while (value > 0) {
+				digit_sum += value % 10;
+				value /= 10;
+			}
+			return digit_sum;
+		}
+
+		auto get_sample(
+			const byte_t* sample_data,
+			size_t sample_index
+		) -> ui32_t {
+			auto offset = sample_index * cdda::STEREO_SAMPLE_LENGTH;
+			return ui32_t(sample_data[offset + 0]) | (ui32_t(sample_data[offset + 1]) << 8) | (ui32_t(sample_data[offset + 2]) << 16) | (ui32_t(sample_data[offset + 3]) << 24);
+		}
+
+		auto get_first_multiplier(
+			bool_t is_first_track
+		) -> size_t {
+			// The multiplier is one-based which means that the first track includes the last sample of its fifth sector.
+			return is_first_track ? SKIPPED_SECTORS * cdda::STEREO_SAMPLES_PER_SECTOR : 1;
+		}
+
+		auto get_last_multiplier(
+			size_t length_sectors,
+			bool_t is_last_track
+		) -> size_t {
+			auto length_samples = length_sectors * cdda::STEREO_SAMPLES_PER_SECTOR;
+			return is_last_track ? length_samples - std::min(length_samples, SKIPPED_SECTORS * cdda::STEREO_SAMPLES_PER_SECTOR) : length_samples;
+		}
 	}
 	}
 
@@ -4573,5 +4613,240 @@ namespace accuraterip {
 		static const auto database = Database();
 		return database;
 	}
+	ChecksumComputer::ChecksumComputer(
+		size_t length_sectors,
+		bool_t is_first_track,
+		bool_t is_last_track
+	) {
+		this->first_multiplier = internal::get_first_multiplier(is_first_track);
+		this->last_multiplier = internal::get_last_multiplier(length_sectors, is_last_track);
+		this->multiplier = 1;
+		this->checksum_v1 = 0;
+		this->checksum_v2 = 0;
+	}
+
+	auto ChecksumComputer::append(
+		const byte_t* sector_data
+	) -> void {
+		for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
+			auto sample = internal::get_sample(sector_data, sample_index);
+			if (this->multiplier >= this->first_multiplier && this->multiplier <= this->last_multiplier) {
+				auto product = ui64_t(sample) * ui64_t(this->multiplier);
+				this->checksum_v1 += ui32_t(product);
+				this->checksum_v2 += ui32_t(product) + ui32_t(product >> 32);
+			}
+			this->multiplier += 1;
+		}
+	}
+
+	auto ChecksumComputer::get_checksums(
+	) const -> TrackChecksums {
+		return {
+			this->checksum_v1,
+			this->checksum_v2
+		};
+	}
+
+	auto compute_offset_checksums(
+		const byte_t* sample_data,
+		size_t length_sectors,
+		size_t max_offset,
+		bool_t is_first_track,
+		bool_t is_last_track
+	) -> std::vector<ui32_t> {
+		auto first_multiplier = internal::get_first_multiplier(is_first_track);
+		auto last_multiplier = internal::get_last_multiplier(length_sectors, is_last_track);
+		auto checksums = std::vector<ui32_t>(2 * max_offset + 1);
+		if (first_multiplier > last_multiplier) {
+			return checksums;
+		}
+		// The checksum and sum of the samples for the lowest offset are computed directly. The buffer index of the sample weighted by a multiplier is one less than the multiplier plus the offset index.
+		auto checksum = ui32_t(0);
+		auto sum = ui32_t(0);
+		for (auto multiplier = first_multiplier; multiplier <= last_multiplier; multiplier += 1) {
+			auto sample = internal::get_sample(sample_data, multiplier - 1);
+			checksum += sample * ui32_t(multiplier);
+			sum += sample;
+		}
+		checksums.at(0) = checksum;
+		// Every following offset shifts the samples by one multiplier which changes the checksum by the sum of the samples and the samples leaving and entering the window.
+		for (auto offset_index = size_t(1); offset_index < checksums.size(); offset_index += 1) {
+			auto leaving_sample = internal::get_sample(sample_data, first_multiplier - 1 + offset_index - 1);
+			auto entering_sample = internal::get_sample(sample_data, last_multiplier + offset_index - 1);
+			sum += entering_sample - leaving_sample;
+			checksum += entering_sample * ui32_t(last_multiplier + 1) - leaving_sample * ui32_t(first_multiplier) - sum;
+			checksums.at(offset_index) = checksum;
+		}
+		return checksums;
+	}
+
+	auto DiscId::get_file_name(
+	) const -> std::string {
+		return std::format("dBAR-{:0>3}-{:0>8x}-{:0>8x}-{:0>8x}.bin", this->track_count, this->disc_id_1, this->disc_id_2, this->cddb_disc_id);
+	}
+
+	auto compute_disc_id(
+		const disc::DiscInfo& disc_info
+	) -> DiscId {
+		auto tracks = std::vector<disc::TrackInfo>();
+		for (const auto& track : disc::get_disc_tracks(disc_info)) {
+			if (track.number > 0) {
+				tracks.push_back(track);
+			}
+		}
+		if (tracks.empty()) {
+			OVERDRIVE_THROW(exceptions::MissingValueException("track"));
+		}
+		auto disc_id = DiscId();
+		disc_id.track_count = 0;
+		disc_id.disc_id_1 = 0;
+		disc_id.disc_id_2 = 0;
+		disc_id.cddb_disc_id = 0;
+		auto lead_out = size_t(0);
+		for (const auto& track : tracks) {
+			if (!disc::is_audio_track(track.type)) {
+				continue;
+			}
+			auto offset = size_t(cd::get_relative_sector_index(track.first_sector_absolute));
+			disc_id.disc_id_1 += offset;
+			disc_id.disc_id_2 += std::max<size_t>(offset, 1) * track.number;
+			disc_id.track_count += 1;
+			disc_id.track_numbers.push_back(track.number);
+			lead_out = size_t(cd::get_relative_sector_index(track.last_sector_absolute));
+		}
+		auto& last_track = tracks.back();
+		// The lead-out of discs with a trailing data session is placed where the audio session would have ended.
+		if (disc_info.sessions.size() > 1 && disc::is_data_track(last_track.type)) {
+			lead_out = size_t(cd::get_relative_sector_index(last_track.first_sector_absolute)) - CD_EXTRA_DATA_TRACK_GAP_SECTORS;
+		}
+		disc_id.disc_id_1 += lead_out;
+		disc_id.disc_id_2 += std::max<size_t>(lead_out, 1) * (disc_id.track_count + 1);
+		auto digit_sum = size_t(0);
+		for (const auto& track : tracks) {
+			digit_sum += internal::get_digit_sum(track.first_sector_absolute / cd::SECTORS_PER_SECOND);
+		}
+		auto length_seconds = last_track.last_sector_absolute / cd::SECTORS_PER_SECOND - tracks.front().first_sector_absolute / cd::SECTORS_PER_SECOND;
+		disc_id.cddb_disc_id = ((digit_sum % 255) << 24) | (length_seconds << 8) | tracks.size();
+		return disc_id;
+	}
+
+	Lookup::Lookup(
+		const DiscId& disc_id,
+		const std::vector<std::vector<DBARTrack>>& pressings
+	) {
+		this->disc_id = disc_id;
+		this->pressings = pressings;
+	}
+
+	auto Lookup::create_checksum_computer(
+		const disc::TrackInfo& track
+	) const -> std::optional<ChecksumComputer> {
+		auto track_index = this->get_track_index(track.number);
+		if (!track_index) {
+			return std::optional<ChecksumComputer>();
+		}
+		auto is_first_track = track_index.value() == 0;
+		auto is_last_track = track_index.value() + 1 == this->disc_id.track_numbers.size();
+		return ChecksumComputer(track.length_sectors, is_first_track, is_last_track);
+	}
+
+	auto Lookup::compute_offset_checksums(
+		const disc::TrackInfo& track,
+		const byte_t* sample_data,
+		size_t max_offset
+	) const -> std::optional<std::vector<ui32_t>> {
+		auto track_index = this->get_track_index(track.number);
+		if (!track_index) {
+			return std::optional<std::vector<ui32_t>>();
+		}
+		auto is_first_track = track_index.value() == 0;
+		auto is_last_track = track_index.value() + 1 == this->disc_id.track_numbers.size();
+		return accuraterip::compute_offset_checksums(sample_data, track.length_sectors, max_offset, is_first_track, is_last_track);
+	}
+
+	auto Lookup::get_confidence(
+		size_t track_number,
+		const TrackChecksums& checksums
+	) const -> std::optional<size_t> {
+		auto confidence_v1 = this->get_checksum_confidence(track_number, checksums.v1);
+		auto confidence_v2 = this->get_checksum_confidence(track_number, checksums.v2);
+		if (confidence_v1 && confidence_v2) {
+			return std::max(confidence_v1.value(), confidence_v2.value());
+		}
+		return confidence_v1 ? confidence_v1 : confidence_v2;
+	}
+
+	auto Lookup::get_checksum_confidence(
+		size_t track_number,
+		ui32_t checksum
+	) const -> std::optional<size_t> {
+		auto track_index = this->get_track_index(track_number);
+		if (!track_index) {
+			return std::optional<size_t>();
+		}
+		auto confidence = std::optional<size_t>();
+		for (const auto& pressing : this->pressings) {
+			if (track_index.value() >= pressing.size()) {
+				continue;
+			}
+			auto& track = pressing.at(track_index.value());
+			if (track.crc != checksum) {
+				continue;
+			}
+			confidence = std::max<size_t>(confidence.value_or(0), track.confidence);
+		}
+		return confidence;
+	}
+
+	auto Lookup::get_pressing_count(
+	) const -> size_t {
+		return this->pressings.size();
+	}
+
+	auto Lookup::get_track_index(
+		size_t track_number
+	) const -> std::optional<size_t> {
+		for (auto track_index = size_t(0); track_index < this->disc_id.track_numbers.size(); track_index += 1) {
+			if (this->disc_id.track_numbers.at(track_index) == track_number) {
+				return track_index;
+			}
+		}
+		return std::optional<size_t>();
+	}
+
+	auto create_lookup(
+		const disc::DiscInfo& disc_info,
+		const std::string& path
+	) -> Lookup {
+		auto disc_id = compute_disc_id(disc_info);
+		OVERDRIVE_LOG("Computed AccurateRip disc id as \"{}\"", disc_id.get_file_name());
+		auto handle = std::fopen(path.c_str(), "rb");
+		if (handle == nullptr) {
+			OVERDRIVE_THROW(exceptions::IOOpenException(path));
+		}
+		auto pressings = std::vector<std::vector<DBARTrack>>();
+		try {
+			auto header = DBARHeader();
+			while (std::fread(&header, sizeof(header), 1, handle) == 1) {
+				auto pressing = std::vector<DBARTrack>(header.track_count);
+				if (header.track_count > 0 && std::fread(pressing.data(), sizeof(DBARTrack) * pressing.size(), 1, handle) != 1) {
+					OVERDRIVE_THROW(exceptions::IOReadException(path));
+				}
+				if (header.track_count != disc_id.track_count) {
+					continue;
+				}
+				if (header.disc_id_1 != disc_id.disc_id_1 || header.disc_id_2 != disc_id.disc_id_2 || header.cddb_disc_id != disc_id.cddb_disc_id) {
+					continue;
+				}
+				pressings.push_back(std::move(pressing));
+			}
+		} catch (...) {
+			std::fclose(handle);
+			throw;
+		}
+		std::fclose(handle);
+		OVERDRIVE_LOG("Found {} AccurateRip pressings matching the disc", pressings.size());
+		return Lookup(disc_id, pressings);
+	}
 }
 }
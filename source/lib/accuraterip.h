@@ -3,6 +3,8 @@
 #include <map>
 #include <optional>
 #include <string>
+#include <vector>
+#include "disc.h"
 #include "shared.h"
 
 namespace overdrive {
@@ -27,5 +29,142 @@ namespace accuraterip {
 
 	auto DATABASE(
 	) -> const Database&;
+
+	const auto SKIPPED_SECTORS = size_t(5);
+	const auto CD_EXTRA_DATA_TRACK_GAP_SECTORS = size_t(11400);
+	const auto MAX_DETECTED_READ_OFFSET_CORRECTION = size_t(2940);
+
+	#pragma pack(push, 1)
+
+	struct DBARHeader {
+		ui08_t track_count;
+		ui32_t disc_id_1;
+		ui32_t disc_id_2;
+		ui32_t cddb_disc_id;
+	};
+
+	static_assert(sizeof(DBARHeader) == 13);
+
+	struct DBARTrack {
+		ui08_t confidence;
+		ui32_t crc;
+		ui32_t frame_450_crc;
+	};
+
+	static_assert(sizeof(DBARTrack) == 9);
+
+	#pragma pack(pop)
+
+	class TrackChecksums {
+		public:
+
+		ui32_t v1;
+		ui32_t v2;
+
+		protected:
+	};
+
+	// Computes the v1 and v2 checksums of a track from its sectors in order. The sectors must have been corrected for the read offset of the drive.
+	class ChecksumComputer {
+		public:
+
+		ChecksumComputer(
+			size_t length_sectors,
+			bool_t is_first_track,
+			bool_t is_last_track
+		);
+
+		auto append(
+			const byte_t* sector_data
+		) -> void;
+
+		auto get_checksums(
+		) const -> TrackChecksums;
+
+		protected:
+
+		size_t first_multiplier;
+		size_t last_multiplier;
+		size_t multiplier;
+		ui32_t checksum_v1;
+		ui32_t checksum_v2;
+	};
+
+	// Computes the v1 checksums of a track for every read offset correction from -max_offset to +max_offset samples. The sample data must start max_offset samples before the track and end max_offset samples after it.
+	auto compute_offset_checksums(
+		const byte_t* sample_data,
+		size_t length_sectors,
+		size_t max_offset,
+		bool_t is_first_track,
+		bool_t is_last_track
+	) -> std::vector<ui32_t>;
+
+	class DiscId {
+		public:
+
+		size_t track_count;
+		ui32_t disc_id_1;
+		ui32_t disc_id_2;
+		ui32_t cddb_disc_id;
+		// The track numbers are listed in the order used by the database.
+		std::vector<size_t> track_numbers;
+
+		auto get_file_name(
+		) const -> std::string;
+
+		protected:
+	};
+
+	auto compute_disc_id(
+		const disc::DiscInfo& disc_info
+	) -> DiscId;
+
+	class Lookup {
+		public:
+
+		Lookup(
+			const DiscId& disc_id,
+			const std::vector<std::vector<DBARTrack>>& pressings
+		);
+
+		auto create_checksum_computer(
+			const disc::TrackInfo& track
+		) const -> std::optional<ChecksumComputer>;
+
+		auto compute_offset_checksums(
+			const disc::TrackInfo& track,
+			const byte_t* sample_data,
+			size_t max_offset
+		) const -> std::optional<std::vector<ui32_t>>;
+
+		// Returns the highest confidence of the pressings matching either checksum of the track.
+		auto get_confidence(
+			size_t track_number,
+			const TrackChecksums& checksums
+		) const -> std::optional<size_t>;
+
+		auto get_checksum_confidence(
+			size_t track_number,
+			ui32_t checksum
+		) const -> std::optional<size_t>;
+
+		auto get_pressing_count(
+		) const -> size_t;
+
+		protected:
+
+		auto get_track_index(
+			size_t track_number
+		) const -> std::optional<size_t>;
+
+		DiscId disc_id;
+		std::vector<std::vector<DBARTrack>> pressings;
+	};
+
+	// Reads the pressings matching the disc from a local file in the dBAR format of the database.
+	auto create_lookup(
+		const disc::DiscInfo& disc_info,
+		const std::string& path
+	) -> Lookup;
 }
 }
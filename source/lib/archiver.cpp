@@ -4,66 +4,554 @@
 #include <cstdio>
 #include <cstring>
 #include <filesystem>
+#include <optional>
 #include "byteswap.h"
 #include "cdda.h"
+#include "cdrom.h"
+#include "cdxa.h"
 #include "exceptions.h"
 #include "idiv.h"
 #include "iso9660.h"
 #include "memory.h"
 #include "string.h"
+#include "vector.h"
 
 namespace overdrive {
 namespace archiver {
-	auto read_audio_track(
-		const drive::Drive& drive,
-		const disc::TrackInfo& track,
-		const options::Options& options
-	) -> std::vector<std::vector<ExtractedSector>> {
-		auto read_correction_samples = options.read_correction.value_or(0);
-		OVERDRIVE_LOG("Using read correction [samples]: {}", read_correction_samples);
-		auto read_correction_bytes = read_correction_samples * si_t(cdda::STEREO_SAMPLE_LENGTH);
-		OVERDRIVE_LOG("Using read correction [bytes]: {}", read_correction_bytes);
-		auto start_offset_bytes = si_t(track.first_sector_absolute * cd::SECTOR_LENGTH) + read_correction_bytes;
-		auto end_offset_bytes = si_t(track.last_sector_absolute * cd::SECTOR_LENGTH) + read_correction_bytes;
-		auto adjusted_first_sector = idiv::floor(start_offset_bytes, cd::SECTOR_LENGTH);
-		auto adjusted_last_sector = idiv::ceil(end_offset_bytes, cd::SECTOR_LENGTH);
-		auto prefix_length = read_correction_bytes - ((adjusted_first_sector - track.first_sector_absolute) * cd::SECTOR_LENGTH);
-		auto suffix_length = cd::SECTOR_LENGTH - prefix_length;
-		if (read_correction_bytes != 0) {
+	namespace internal {
+	namespace {
+		auto has_sync_pattern(
+			const ExtractedSector& extracted_sector
+		) -> bool_t {
+			auto sync_header = cdrom::SyncHeader();
+			return std::memcmp(extracted_sector.sector_data, sync_header.sync, sizeof(sync_header.sync)) == 0;
+		}
+
+		auto has_edc(
+			const ExtractedSector& extracted_sector
+		) -> bool_t {
+			if (!has_sync_pattern(extracted_sector)) {
+				return false;
+			}
+			auto& sector = *reinterpret_cast<const cdxa::Sector*>(extracted_sector.sector_data);
+			if (sector.base.header.mode == 1) {
+				return true;
+			}
+			if (sector.base.header.mode == 2) {
+				return sector.base.header_1.form_2 == 0 || cdrom::decode_edc(sector.mode2form2.optional_edc) != 0;
+			}
+			return false;
+		}
+
+		// Data sectors are known to be correct when both the EDC and the ECC check out. Damaged sectors are repaired using the ECC with the C2 data locating erasures.
+		auto verify_sector(
+			ExtractedSector& extracted_sector,
+			si_t sector_index
+		) -> bool_t {
+			if (!has_sync_pattern(extracted_sector)) {
+				return false;
+			}
+			auto& sector = *reinterpret_cast<cdrom::Sector*>(extracted_sector.sector_data);
+			if (sector.base.header.mode == 1) {
+				if (cdrom::is_valid_mode1_sector(sector.mode1)) {
+					return true;
+				}
+				if (cdrom::correct_mode1_sector(sector.mode1, extracted_sector.c2_data)) {
+					OVERDRIVE_LOG("Repaired sector {} using ECC", sector_index);
+					return true;
+				}
+				return false;
+			}
+			if (sector.base.header.mode == 2) {
+				auto& xa_sector = *reinterpret_cast<cdxa::Sector*>(extracted_sector.sector_data);
+				if (xa_sector.base.header_1.form_2 == 0) {
+					if (cdxa::is_valid_mode2_form1_sector(xa_sector.mode2form1)) {
+						return true;
+					}
+					if (cdxa::correct_mode2_form1_sector(xa_sector.mode2form1, extracted_sector.c2_data)) {
+						OVERDRIVE_LOG("Repaired sector {} using ECC", sector_index);
+						return true;
+					}
+					return false;
+				} else {
+					return cdxa::is_valid_mode2_form2_sector(xa_sector.mode2form2);
+				}
+			}
+			return false;
+		}
+
+		class SectorRun {
+			public:
+
+			si_t first_sector;
+			size_t sector_count;
+
+			protected:
+		};
+
+		auto get_unconverged_sector_runs(
+			const std::vector<CandidateStore>& candidate_stores,
+			si_t first_sector,
+			std::optional<size_t> required_copies,
+			size_t max_gap_sectors,
+			size_t max_run_sectors
+		) -> std::vector<SectorRun> {
+			auto runs = std::vector<SectorRun>();
+			auto run_first_offset = std::optional<size_t>();
+			auto run_last_offset = size_t(0);
+			for (auto sector_offset = size_t(0); sector_offset < candidate_stores.size(); sector_offset += 1) {
+				// Verified sectors are only skipped once every sector has been read during the first passes.
+				if (required_copies && candidate_stores.at(sector_offset).is_verified()) {
+					continue;
+				}
+				if (required_copies && candidate_stores.at(sector_offset).get_leader_counter() >= required_copies.value()) {
+					continue;
+				}
+				// Short gaps of converged sectors are read again since a separate command costs more than the extra sectors.
+				if (run_first_offset && sector_offset - run_last_offset <= max_gap_sectors + 1 && sector_offset - run_first_offset.value() < max_run_sectors) {
+					run_last_offset = sector_offset;
+					continue;
+				}
+				if (run_first_offset) {
+					runs.push_back({ first_sector + si_t(run_first_offset.value()), run_last_offset - run_first_offset.value() + 1 });
+				}
+				run_first_offset = sector_offset;
+				run_last_offset = sector_offset;
+			}
+			if (run_first_offset) {
+				runs.push_back({ first_sector + si_t(run_first_offset.value()), run_last_offset - run_first_offset.value() + 1 });
+			}
+			return runs;
+		}
+
+		auto complete_sector_range(
+			const drive::Drive& drive,
+			drive::PendingSectorRange& range,
+			std::vector<ExtractedSector>& sectors,
+			std::vector<bool_t>& successes,
+			bool_t reread_failed_sectors
+		) -> bool_t {
+			auto first_sector = range.first_absolute_index;
+			auto sector_count = range.sector_count;
+			sectors.assign(sector_count, ExtractedSector());
+			successes.assign(sector_count, false);
+			try {
+				drive.complete_absolute_sector_range(range, [&](size_t sector_offset, const array<cd::SECTOR_LENGTH, byte_t>& sector_data, const array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data, const array<cd::C2_LENGTH, byte_t>& c2_data) -> void {
+					auto& sector = sectors.at(sector_offset);
+					std::memcpy(sector.sector_data, sector_data, sizeof(sector.sector_data));
+					std::memcpy(sector.subchannels_data, subchannels_data, sizeof(sector.subchannels_data));
+					std::memcpy(sector.c2_data, c2_data, sizeof(sector.c2_data));
+					successes.at(sector_offset) = true;
+				});
+				return true;
+			} catch (const exceptions::SCSIException& e) {}
+			if (!reread_failed_sectors) {
+				return false;
+			}
+			// One bad sector fails the entire command so the sectors not yet delivered are re-read one sector at a time.
+			for (auto sector_offset = size_t(0); sector_offset < sector_count; sector_offset += 1) {
+				if (successes.at(sector_offset)) {
+					continue;
+				}
+				auto sector_index = first_sector + si_t(sector_offset);
+				auto& sector = sectors.at(sector_offset);
+				try {
+					drive.read_absolute_sector(sector_index, &sector.sector_data, &sector.subchannels_data, &sector.c2_data);
+					successes.at(sector_offset) = true;
+				} catch (const exceptions::SCSIException& e) {
+					OVERDRIVE_LOG("Error reading sector {}!", sector_index);
+				}
+			}
+			return false;
+		}
+
+		auto store_extracted_sector(
+			std::vector<CandidateStore>& candidate_stores,
+			si_t first_sector,
+			si_t sector_index,
+			ExtractedSector& sector,
+			bool_t success
+		) -> void {
+			if (!memory::test(&sector.c2_data, sizeof(sector.c2_data), 0)) {
+				OVERDRIVE_LOG("C2 errors occured for sector {}!", sector_index);
+			}
+			auto& candidate_store = candidate_stores.at(sector_index - first_sector);
+			auto verified = false;
+			if (success) {
+				auto& subchannels = *reinterpret_cast<cd::Subchannels*>(&sector.subchannels_data);
+				subchannels = cd::deinterleave_subchannels(subchannels);
+				cd::correct_subchannels(subchannels, sector_index);
+				subchannels = cd::reinterleave_subchannels(subchannels);
+				auto is_c2_clean = memory::test(&sector.c2_data, sizeof(sector.c2_data), 0);
+				verified = has_edc(sector) ? verify_sector(sector, sector_index) : is_c2_clean;
+				// Reads with C2 errors are merged byte by byte with the earlier reads since the merged sector may verify before any single read does.
+				if (!verified && !is_c2_clean && !candidate_store.is_verified()) {
+					auto merged_sector = candidate_store.merge(sector);
+					auto is_merged_c2_clean = memory::test(&merged_sector.c2_data, sizeof(merged_sector.c2_data), 0);
+					if (has_edc(merged_sector) ? verify_sector(merged_sector, sector_index) : is_merged_c2_clean) {
+						OVERDRIVE_LOG("Merged sector {} from reads with C2 errors", sector_index);
+						sector = merged_sector;
+						verified = true;
+					}
+				}
+			}
+			candidate_store.add(sector, success, verified);
+		}
+
+		auto read_and_store_sector(
+			const drive::Drive& drive,
+			std::vector<CandidateStore>& candidate_stores,
+			si_t first_sector,
+			si_t sector_index
+		) -> bool_t {
+			auto sector = ExtractedSector();
+			auto success = false;
+			try {
+				drive.read_absolute_sector(sector_index, &sector.sector_data, &sector.subchannels_data, &sector.c2_data);
+				success = true;
+			} catch (const exceptions::SCSIException& e) {
+				OVERDRIVE_LOG("Error reading sector {}!", sector_index);
+			}
+			store_extracted_sector(candidate_stores, first_sector, sector_index, sector, success);
+			return success;
+		}
+
+		auto correct_subchannel_packs(
+			std::vector<CandidateStore>& candidate_stores,
+			si_t first_sector
+		) -> void {
+			auto subchannels_data = std::vector<pointer<array<cd::SUBCHANNELS_LENGTH, byte_t>>>();
+			subchannels_data.reserve(candidate_stores.size());
+			for (auto& candidate_store : candidate_stores) {
+				subchannels_data.push_back(&candidate_store.get_leader().subchannels_data);
+			}
+			cd::correct_subchannel_packs(subchannels_data, first_sector);
+		}
+
+		auto survey_sector_range(
+			const drive::Drive& drive,
+			std::vector<CandidateStore>& candidate_stores,
+			si_t first_sector,
+			si_t last_sector,
+			size_t sectors_per_command,
+			size_t sectors_per_read
+		) -> std::vector<SectorRun> {
+			auto skipped_runs = std::vector<SectorRun>();
+			auto sectors = std::vector<ExtractedSector>();
+			auto successes = std::vector<bool_t>();
+			auto skip_sectors = sectors_per_command;
+			auto range_first_sector = first_sector;
+			auto pending_range = std::optional<drive::PendingSectorRange>();
+			while (range_first_sector < last_sector) {
+				auto sector_count = std::min<size_t>(sectors_per_read, last_sector - range_first_sector);
+				if (!pending_range) {
+					pending_range.emplace(drive.submit_absolute_sector_range(range_first_sector, sector_count));
+				}
+				auto success = complete_sector_range(drive, pending_range.value(), sectors, successes, false);
+				pending_range.reset();
+				auto next_range_first_sector = range_first_sector + si_t(sector_count);
+				if (success && next_range_first_sector < last_sector) {
+					pending_range.emplace(drive.submit_absolute_sector_range(next_range_first_sector, std::min<size_t>(sectors_per_read, last_sector - next_range_first_sector)));
+				}
+				auto delivered_sector_count = size_t(0);
+				while (delivered_sector_count < sector_count && successes.at(delivered_sector_count)) {
+					delivered_sector_count += 1;
+				}
+				for (auto sector_offset = size_t(0); sector_offset < delivered_sector_count; sector_offset += 1) {
+					store_extracted_sector(candidate_stores, first_sector, range_first_sector + si_t(sector_offset), sectors.at(sector_offset), true);
+				}
+				if (success) {
+					skip_sectors = sectors_per_command;
+					range_first_sector = next_range_first_sector;
+					continue;
+				}
+				// The region following a failure is skipped and the skip size doubles for every consecutive failure.
+				auto skipped_first_sector = range_first_sector + si_t(delivered_sector_count);
+				auto skipped_sector_count = std::min<size_t>(std::max(skip_sectors, sector_count - delivered_sector_count), last_sector - skipped_first_sector);
+				OVERDRIVE_LOG("Skipping {} sectors from {} during survey", skipped_sector_count, skipped_first_sector);
+				if (!skipped_runs.empty() && skipped_runs.back().first_sector + si_t(skipped_runs.back().sector_count) == skipped_first_sector) {
+					skipped_runs.back().sector_count += skipped_sector_count;
+				} else {
+					skipped_runs.push_back({ skipped_first_sector, skipped_sector_count });
+				}
+				skip_sectors = std::min(skip_sectors * 2, MAX_SURVEY_SKIP_SECTORS);
+				range_first_sector = skipped_first_sector + si_t(skipped_sector_count);
+			}
+			return skipped_runs;
+		}
+
+		auto rescue_sector_run(
+			const drive::Drive& drive,
+			std::vector<CandidateStore>& candidate_stores,
+			si_t first_sector,
+			const SectorRun& run
+		) -> void {
+			auto run_first_sector = run.first_sector;
+			auto run_last_sector = run.first_sector + si_t(run.sector_count);
+			OVERDRIVE_LOG("Rescuing {} sectors from {} to {}", run.sector_count, run_first_sector, run_last_sector);
+			// The damaged region is approached from both edges before the sectors in between are read one by one.
+			while (run_first_sector < run_last_sector) {
+				auto success = read_and_store_sector(drive, candidate_stores, first_sector, run_first_sector);
+				run_first_sector += 1;
+				if (!success) {
+					break;
+				}
+			}
+			while (run_first_sector < run_last_sector) {
+				auto success = read_and_store_sector(drive, candidate_stores, first_sector, run_last_sector - 1);
+				run_last_sector -= 1;
+				if (!success) {
+					break;
+				}
+			}
+			for (auto sector_index = run_first_sector; sector_index < run_last_sector; sector_index += 1) {
+				read_and_store_sector(drive, candidate_stores, first_sector, sector_index);
+			}
+		}
+
+		auto get_read_correction_bytes(
+			const options::Options& options
+		) -> si_t {
+			return options.read_correction.value_or(0) * si_t(cdda::STEREO_SAMPLE_LENGTH);
+		}
+
+		auto get_adjusted_first_sector(
+			si_t first_sector,
+			si_t read_correction_bytes
+		) -> si_t {
+			return idiv::floor(first_sector * si_t(cd::SECTOR_LENGTH) + read_correction_bytes, cd::SECTOR_LENGTH);
+		}
+
+		auto get_adjusted_last_sector(
+			si_t last_sector,
+			si_t read_correction_bytes
+		) -> si_t {
+			return idiv::ceil(last_sector * si_t(cd::SECTOR_LENGTH) + read_correction_bytes, cd::SECTOR_LENGTH);
+		}
+
+		auto stream_offset_corrected_audio_range(
+			const drive::Drive& drive,
+			si_t first_sector,
+			si_t last_sector,
+			const options::Options& options,
+			pointer<journal::Journal> journal,
+			const sector_sink_t& sink
+		) -> std::vector<size_t> {
+			auto read_correction_samples = options.read_correction.value_or(0);
+			OVERDRIVE_LOG("Using read correction [samples]: {}", read_correction_samples);
+			auto read_correction_bytes = get_read_correction_bytes(options);
+			OVERDRIVE_LOG("Using read correction [bytes]: {}", read_correction_bytes);
+			auto adjusted_first_sector = get_adjusted_first_sector(first_sector, read_correction_bytes);
+			auto adjusted_last_sector = get_adjusted_last_sector(last_sector, read_correction_bytes);
+			auto prefix_length = read_correction_bytes - ((adjusted_first_sector - first_sector) * si_t(cd::SECTOR_LENGTH));
+			auto suffix_length = cd::SECTOR_LENGTH - prefix_length;
+			if (read_correction_bytes == 0) {
+				return stream_absolute_sector_range(
+					drive,
+					adjusted_first_sector,
+					adjusted_last_sector,
+					options.min_audio_passes,
+					options.max_audio_passes,
+					options.max_audio_retries,
+					options.min_audio_copies,
+					options.max_audio_copies,
+					options.rescue,
+					options.max_memory,
+					journal,
+					sink
+				);
+			}
 			OVERDRIVE_LOG("Adjusted sector range is from {} to {}", adjusted_first_sector, adjusted_last_sector);
 			OVERDRIVE_LOG("The first {} bytes of sector data will be discarded", prefix_length);
 			OVERDRIVE_LOG("The last {} bytes of sector data will be discarded", suffix_length);
-		}
-		auto extracted_sectors_vector = read_absolute_sector_range(
-			drive,
-			adjusted_first_sector,
-			adjusted_last_sector,
-			options.min_audio_passes,
-			options.max_audio_passes,
-			options.max_audio_retries,
-			options.min_audio_copies,
-			options.max_audio_copies
-		);
-		if (read_correction_bytes != 0) {
-			for (auto sector_index = track.first_sector_absolute; sector_index < track.last_sector_absolute; sector_index += 1) {
-				auto& extracted_sectors = extracted_sectors_vector.at(sector_index - track.first_sector_absolute);
-				auto& extracted_sector = extracted_sectors.at(0);
-				std::memmove(&extracted_sector.sector_data[0], &extracted_sector.sector_data[prefix_length], suffix_length);
-				auto& next_extracted_sectors = extracted_sectors_vector.at(sector_index - track.first_sector_absolute + 1);
-				auto& next_extracted_sector = next_extracted_sectors.at(0);
+			auto bad_sector_indices = std::vector<size_t>();
+			auto previous_extracted_sector = ExtractedSector();
+			auto previous_is_readable = false;
+			auto sector_index = first_sector;
+			// Every sector is emitted once the following sector has been extracted since it contributes the last bytes.
+			auto emit_sector = [&](const ExtractedSector& next_extracted_sector) -> void {
+				auto extracted_sector = previous_extracted_sector;
+				std::memmove(&extracted_sector.sector_data[0], &previous_extracted_sector.sector_data[prefix_length], suffix_length);
 				std::memmove(&extracted_sector.sector_data[suffix_length], &next_extracted_sector.sector_data[0], prefix_length);
+				if (!previous_is_readable) {
+					bad_sector_indices.push_back(sector_index);
+				}
+				sink(sector_index, extracted_sector, previous_is_readable);
+				sector_index += 1;
+			};
+			stream_absolute_sector_range(
+				drive,
+				adjusted_first_sector,
+				adjusted_last_sector,
+				options.min_audio_passes,
+				options.max_audio_passes,
+				options.max_audio_retries,
+				options.min_audio_copies,
+				options.max_audio_copies,
+				options.rescue,
+				options.max_memory,
+				journal,
+				[&](si_t adjusted_sector_index, const ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+					if (adjusted_sector_index > adjusted_first_sector && sector_index < last_sector) {
+						emit_sector(extracted_sector);
+					}
+					previous_extracted_sector = extracted_sector;
+					previous_is_readable = is_readable;
+				}
+			);
+			if (sector_index < last_sector) {
+				emit_sector(ExtractedSector());
+			}
+			return bad_sector_indices;
+		}
+
+		// Streams the sectors of contiguous tracks as a single range while keeping track of which track every sector belongs to.
+		auto stream_contiguous_tracks(
+			const std::vector<disc::TrackInfo>& tracks,
+			const track_sink_t& sink,
+			const std::function<void(si_t first_sector, si_t last_sector, const sector_sink_t& sink)>& stream_range
+		) -> std::vector<std::vector<size_t>> {
+			auto bad_sector_indices = std::vector<std::vector<size_t>>(tracks.size());
+			auto track_index = size_t(0);
+			stream_range(tracks.front().first_sector_absolute, tracks.back().last_sector_absolute, [&](si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+				while (sector_index >= si_t(tracks.at(track_index).last_sector_absolute)) {
+					track_index += 1;
+				}
+				if (!is_readable) {
+					bad_sector_indices.at(track_index).push_back(sector_index);
+				}
+				sink(track_index, sector_index, extracted_sector, is_readable);
+			});
+			return bad_sector_indices;
+		}
+	}
+	}
+
+	auto stream_audio_track(
+		const drive::Drive& drive,
+		const disc::TrackInfo& track,
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t> {
+		auto bad_sector_indices = stream_audio_tracks(drive, { track }, options, lookup, journal, [&](size_t track_index, si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+			(void)track_index;
+			sink(sector_index, extracted_sector, is_readable);
+		});
+		return bad_sector_indices.front();
+	}
+
+	auto stream_audio_tracks(
+		const drive::Drive& drive,
+		const std::vector<disc::TrackInfo>& tracks,
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const track_sink_t& sink
+	) -> std::vector<std::vector<size_t>> {
+		auto checksum_computers = std::vector<std::optional<accuraterip::ChecksumComputer>>();
+		for (const auto& track : tracks) {
+			checksum_computers.push_back(lookup != nullptr ? lookup->create_checksum_computer(track) : std::optional<accuraterip::ChecksumComputer>());
+		}
+		auto has_checksums = std::any_of(checksum_computers.begin(), checksum_computers.end(), [](const std::optional<accuraterip::ChecksumComputer>& checksum_computer) -> bool_t {
+			return checksum_computer.has_value();
+		});
+		auto stream_run = [&](const options::Options& run_options, std::vector<std::optional<accuraterip::ChecksumComputer>>& run_checksum_computers, const track_sink_t& run_sink) -> std::vector<std::vector<size_t>> {
+			return internal::stream_contiguous_tracks(tracks, [&](size_t track_index, si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+				auto& checksum_computer = run_checksum_computers.at(track_index);
+				if (checksum_computer) {
+					checksum_computer->append(extracted_sector.sector_data);
+				}
+				run_sink(track_index, sector_index, extracted_sector, is_readable);
+			}, [&](si_t first_sector, si_t last_sector, const sector_sink_t& range_sink) -> void {
+				internal::stream_offset_corrected_audio_range(drive, first_sector, last_sector, run_options, journal, range_sink);
+			});
+		};
+		// A single pass is spooled into the journal. The sectors of tracks matching a known pressing are replayed while the sectors of the other tracks are erased and extracted again.
+		if (has_checksums && journal != nullptr && options.min_audio_passes > 1) {
+			auto first_pass_options = options;
+			first_pass_options.min_audio_passes = 1;
+			first_pass_options.max_audio_passes = 1;
+			first_pass_options.min_audio_copies = 0;
+			auto first_pass_checksum_computers = checksum_computers;
+			auto bad_sector_indices = stream_run(first_pass_options, first_pass_checksum_computers, [&](size_t track_index, si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+				(void)track_index;
+				(void)sector_index;
+				(void)extracted_sector;
+				(void)is_readable;
+			});
+			auto read_correction_bytes = internal::get_read_correction_bytes(options);
+			for (auto track_index = size_t(0); track_index < tracks.size(); track_index += 1) {
+				auto& track = tracks.at(track_index);
+				auto& checksum_computer = first_pass_checksum_computers.at(track_index);
+				if (checksum_computer && bad_sector_indices.at(track_index).empty()) {
+					auto confidence = lookup->get_confidence(track.number, checksum_computer->get_checksums());
+					if (confidence) {
+						OVERDRIVE_LOG("Track number {} matched AccurateRip with confidence {} after a single pass", track.number, confidence.value());
+						continue;
+					}
+				}
+				OVERDRIVE_LOG("Track number {} did not match AccurateRip after a single pass", track.number);
+				auto adjusted_first_sector = internal::get_adjusted_first_sector(track.first_sector_absolute, read_correction_bytes);
+				auto adjusted_last_sector = internal::get_adjusted_last_sector(track.last_sector_absolute, read_correction_bytes);
+				for (auto sector_index = adjusted_first_sector; sector_index < adjusted_last_sector; sector_index += 1) {
+					journal->erase(sector_index);
+				}
+			}
+			journal->flush();
+		}
+		auto bad_sector_indices = stream_run(options, checksum_computers, sink);
+		for (auto track_index = size_t(0); track_index < tracks.size(); track_index += 1) {
+			auto& track = tracks.at(track_index);
+			auto& checksum_computer = checksum_computers.at(track_index);
+			if (!checksum_computer) {
+				continue;
+			}
+			auto checksums = checksum_computer->get_checksums();
+			auto confidence = lookup->get_confidence(track.number, checksums);
+			if (confidence) {
+				OVERDRIVE_LOG("Track number {} matched AccurateRip with confidence {}", track.number, confidence.value());
+			} else {
+				OVERDRIVE_LOG("Track number {} did not match AccurateRip with checksums {:0>8X} (v1) and {:0>8X} (v2)", track.number, checksums.v1, checksums.v2);
 			}
-			extracted_sectors_vector.resize(track.length_sectors); // This hides read errors in the last sector.
 		}
-		return extracted_sectors_vector;
+		return bad_sector_indices;
+	}
+
+	auto stream_data_tracks(
+		const drive::Drive& drive,
+		const std::vector<disc::TrackInfo>& tracks,
+		const options::Options& options,
+		pointer<journal::Journal> journal,
+		const track_sink_t& sink
+	) -> std::vector<std::vector<size_t>> {
+		return internal::stream_contiguous_tracks(tracks, sink, [&](si_t first_sector, si_t last_sector, const sector_sink_t& range_sink) -> void {
+			stream_absolute_sector_range(
+				drive,
+				first_sector,
+				last_sector,
+				options.min_data_passes,
+				options.max_data_passes,
+				options.max_data_retries,
+				options.min_data_copies,
+				options.max_data_copies,
+				options.rescue,
+				options.max_memory,
+				journal,
+				range_sink
+			);
+		});
 	}
 
-	auto read_data_track(
+	auto stream_data_track(
 		const drive::Drive& drive,
 		const disc::TrackInfo& track,
-		const options::Options& options
-	) -> std::vector<std::vector<ExtractedSector>> {
-		return read_absolute_sector_range(
+		const options::Options& options,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t> {
+		return stream_absolute_sector_range(
 			drive,
 			track.first_sector_absolute,
 			track.last_sector_absolute,
@@ -71,7 +559,11 @@ namespace archiver {
 			options.max_data_passes,
 			options.max_data_retries,
 			options.min_data_copies,
-			options.max_data_copies
+			options.max_data_copies,
+			options.rescue,
+			options.max_memory,
+			journal,
+			sink
 		);
 	}
 
@@ -93,47 +585,145 @@ namespace archiver {
 		return std::memcmp(this->c2_data, that.c2_data, sizeof(c2_data)) == 0;
 	}
 
-	auto get_number_of_identical_copies(
-		std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector
-	) -> size_t {
-		auto counters = std::vector<size_t>(1);
-		for (auto sector_index = size_t(0); sector_index < extracted_sectors_vector.size(); sector_index += 1) {
-			auto& extracted_sectors = extracted_sectors_vector.at(sector_index);
-			if (extracted_sectors.size() > 0) {
-				// Sort in decreasing order.
-				std::sort(extracted_sectors.begin(), extracted_sectors.end(), [](const ExtractedSector& one, const ExtractedSector& two) -> bool_t {
-					return two.counter < one.counter;
-				});
-				auto& extracted_sector = extracted_sectors.at(0);
-				counters.resize(std::max(extracted_sector.counter + 1, counters.size()));
-				counters.at(extracted_sector.counter) += 1;
+	CandidateStore::CandidateStore(
+	) {
+		this->leader_index = 0;
+		this->leader = ExtractedSector();
+		this->verified = false;
+	}
+
+	auto CandidateStore::add(
+		const ExtractedSector& sector,
+		bool_t success,
+		bool_t verified
+	) -> void {
+		auto hash = memory::hash(sector.sector_data, sizeof(sector.sector_data), 0);
+		hash = memory::hash(sector.subchannels_data, sizeof(sector.subchannels_data), hash);
+		auto candidate_index = size_t(0);
+		while (candidate_index < this->candidates.size() && this->candidates.at(candidate_index).hash != hash) {
+			candidate_index += 1;
+		}
+		if (candidate_index == this->candidates.size()) {
+			this->candidates.push_back({ hash, 0 });
+			if (candidate_index == 0) {
+				this->leader = sector;
+			}
+		}
+		auto& candidate = this->candidates.at(candidate_index);
+		if (success) {
+			candidate.counter += 1;
+		}
+		if (verified && !this->verified) {
+			this->leader = sector;
+			this->leader_index = candidate_index;
+			this->verified = true;
+			// The merged sector is no longer needed once the sector has been verified.
+			this->merged_sector.reset();
+		}
+		if (!this->verified && candidate_index != this->leader_index && candidate.counter > this->candidates.at(this->leader_index).counter) {
+			this->leader = sector;
+			this->leader_index = candidate_index;
+		}
+		this->leader.counter = this->candidates.at(this->leader_index).counter;
+	}
+
+	auto CandidateStore::merge(
+		const ExtractedSector& sector
+	) -> ExtractedSector {
+		if (!this->merged_sector) {
+			this->merged_sector = std::make_unique<MergedSector>();
+			std::memset(this->merged_sector->sector_data, 0, sizeof(this->merged_sector->sector_data));
+			std::memset(this->merged_sector->c2_data, 0xFF, sizeof(this->merged_sector->c2_data));
+			std::memset(this->merged_sector->votes, 0, sizeof(this->merged_sector->votes));
+		}
+		auto& merged_sector = *this->merged_sector;
+		for (auto byte_index = size_t(0); byte_index < cd::SECTOR_LENGTH; byte_index += 1) {
+			auto bit_mask = byte_t(0x80 >> (byte_index & 7));
+			auto is_clean = (sector.c2_data[byte_index >> 3] & bit_mask) == 0;
+			auto was_clean = (merged_sector.c2_data[byte_index >> 3] & bit_mask) == 0;
+			auto byte = sector.sector_data[byte_index];
+			if (was_clean && !is_clean) {
+				continue;
+			}
+			if (is_clean && !was_clean) {
+				merged_sector.sector_data[byte_index] = byte;
+				merged_sector.votes[byte_index] = 1;
+				merged_sector.c2_data[byte_index >> 3] &= ~bit_mask;
+				continue;
+			}
+			// Conflicting reads are resolved by majority vote (Boyer-Moore).
+			auto& votes = merged_sector.votes[byte_index];
+			if (merged_sector.sector_data[byte_index] == byte) {
+				if (votes < 255) {
+					votes += 1;
+				}
+			} else if (votes == 0) {
+				merged_sector.sector_data[byte_index] = byte;
+				votes = 1;
 			} else {
-				counters.at(0) += 1;
+				votes -= 1;
 			}
 		}
-		for (auto counter_index = size_t(0); counter_index < counters.size(); counter_index += 1) {
-			auto counter = counters.at(counter_index);
-			if (counter != 0) {
-				return counter_index;
+		auto merged_extracted_sector = sector;
+		std::memcpy(merged_extracted_sector.sector_data, merged_sector.sector_data, sizeof(merged_extracted_sector.sector_data));
+		std::memcpy(merged_extracted_sector.c2_data, merged_sector.c2_data, sizeof(merged_extracted_sector.c2_data));
+		return merged_extracted_sector;
+	}
+
+	auto CandidateStore::get_leader(
+	) const -> const ExtractedSector& {
+		return this->leader;
+	}
+
+	auto CandidateStore::get_leader(
+	) -> ExtractedSector& {
+		return this->leader;
+	}
+
+	auto CandidateStore::get_leader_counter(
+	) const -> size_t {
+		return this->leader.counter;
+	}
+
+	auto CandidateStore::get_candidate_count(
+	) const -> size_t {
+		return this->candidates.size();
+	}
+
+	auto CandidateStore::is_verified(
+	) const -> bool_t {
+		return this->verified;
+	}
+
+	auto get_number_of_identical_copies(
+		const std::vector<CandidateStore>& candidate_stores,
+		size_t verified_copies
+	) -> size_t {
+		if (candidate_stores.empty()) {
+			return 0;
+		}
+		auto get_copies = [&](const CandidateStore& candidate_store) -> size_t {
+			if (candidate_store.is_verified()) {
+				return std::max(candidate_store.get_leader_counter(), verified_copies);
 			}
+			return candidate_store.get_leader_counter();
+		};
+		auto number_of_identical_copies = get_copies(candidate_stores.front());
+		for (auto& candidate_store : candidate_stores) {
+			number_of_identical_copies = std::min(number_of_identical_copies, get_copies(candidate_store));
 		}
-		return 0;
+		return number_of_identical_copies;
 	}
 
 	auto get_bad_sector_indices(
-		const std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector,
+		const std::vector<CandidateStore>& candidate_stores,
 		size_t first_sector
 	) -> std::vector<size_t> {
 		auto bad_sector_indices = std::vector<size_t>();
-		for (auto sector_index = size_t(0); sector_index < extracted_sectors_vector.size(); sector_index += 1) {
-			auto& extracted_sectors = extracted_sectors_vector.at(sector_index);
-			if (extracted_sectors.size() == 0) {
+		for (auto sector_index = size_t(0); sector_index < candidate_stores.size(); sector_index += 1) {
+			auto& candidate_store = candidate_stores.at(sector_index);
+			if (candidate_store.get_leader_counter() == 0) {
 				bad_sector_indices.push_back(first_sector + sector_index);
-			} else {
-				auto& extracted_sector = extracted_sectors.at(0);
-				if (extracted_sector.counter == 0) {
-					bad_sector_indices.push_back(first_sector + sector_index);
-				}
 			}
 		}
 		return bad_sector_indices;
@@ -180,99 +770,288 @@ namespace archiver {
 		size_t max_passes,
 		size_t max_retries,
 		size_t min_copies,
-		size_t max_copies
-	) -> std::vector<std::vector<ExtractedSector>> {
+		size_t max_copies,
+		bool_t rescue
+	) -> std::vector<CandidateStore> {
 		auto length_sectors = last_sector - first_sector;
 		OVERDRIVE_LOG("Extracting sector range containing {} sectors from {} to {}", length_sectors, first_sector, last_sector);
-		auto extracted_sectors_vector = std::vector<std::vector<ExtractedSector>>(length_sectors);
+		auto candidate_stores = std::vector<CandidateStore>(length_sectors);
 		drive.set_read_retry_count(max_retries);
-		for (auto pass_index = size_t(0); pass_index < max_passes; pass_index += 1) {
+		auto sectors_per_command = drive.get_max_sectors_per_read();
+		auto queue_depth = drive.get_queue_depth();
+		auto sectors_per_read = sectors_per_command * queue_depth;
+		OVERDRIVE_LOG("Reading up to {} sectors per command with up to {} commands in flight", sectors_per_command, queue_depth);
+		auto sectors = std::vector<ExtractedSector>();
+		auto successes = std::vector<bool_t>();
+		auto first_pass_index = size_t(0);
+		if (rescue && max_passes > 0) {
+			OVERDRIVE_LOG("Running survey pass");
+			drive.set_read_retry_count(0);
+			auto skipped_runs = internal::survey_sector_range(drive, candidate_stores, first_sector, last_sector, sectors_per_command, sectors_per_read);
+			OVERDRIVE_LOG("Running rescue of {} skipped regions", skipped_runs.size());
+			drive.set_read_retry_count(max_retries);
+			for (auto& skipped_run : skipped_runs) {
+				internal::rescue_sector_run(drive, candidate_stores, first_sector, skipped_run);
+			}
+			first_pass_index = 1;
+		}
+		for (auto pass_index = first_pass_index; pass_index < max_passes; pass_index += 1) {
 			OVERDRIVE_LOG("Running pass {}", pass_index + 1);
-			for (auto sector_index = first_sector; sector_index < last_sector; sector_index += 1) {
-				auto sector = ExtractedSector();
-				auto success = false;
-				try {
-					drive.read_absolute_sector(sector_index, &sector.sector_data, &sector.subchannels_data, &sector.c2_data);
-					success = true;
-				} catch (const exceptions::SCSIException& e) {
-					OVERDRIVE_LOG("Error reading sector {}!", sector_index);
-				}
-				if (!memory::test(&sector.c2_data, sizeof(sector.c2_data), 0)) {
-					OVERDRIVE_LOG("C2 errors occured for sector {}!", sector_index);
-				}
-				if (success) {
-					auto& subchannels = *reinterpret_cast<cd::Subchannels*>(&sector.subchannels_data);
-					subchannels = cd::deinterleave_subchannels(subchannels);
-					cd::correct_subchannels(subchannels, sector_index);
-					subchannels = cd::reinterleave_subchannels(subchannels);
-				}
-				auto& extracted_sectors = extracted_sectors_vector.at(sector_index - first_sector);
-				auto extracted_sector_with_matching_data = pointer<ExtractedSector>(nullptr);
-				for (auto& extracted_sector : extracted_sectors) {
-					if (extracted_sector.has_identical_sector_data(sector) && extracted_sector.has_identical_subchannels_data(sector)) {
-						extracted_sector_with_matching_data = &extracted_sector;
-						break;
-					}
-				}
-				if (!extracted_sector_with_matching_data) {
-					extracted_sectors.push_back(std::move(sector));
-					extracted_sector_with_matching_data = &extracted_sectors.back();
+			// Every sector is read during the first passes while later passes only revisit the sectors that have neither converged nor verified.
+			auto required_copies = std::optional<size_t>();
+			if (pass_index >= min_passes) {
+				required_copies = max_copies;
+			}
+			auto runs = internal::get_unconverged_sector_runs(candidate_stores, first_sector, required_copies, sectors_per_command, sectors_per_read);
+			if (runs.empty()) {
+				break;
+			}
+			OVERDRIVE_LOG("Reading {} sector runs", runs.size());
+			auto pending_range = std::optional<drive::PendingSectorRange>();
+			pending_range.emplace(drive.submit_absolute_sector_range(runs.front().first_sector, runs.front().sector_count));
+			for (auto run_index = size_t(0); run_index < runs.size(); run_index += 1) {
+				auto range_first_sector = runs.at(run_index).first_sector;
+				auto sector_count = runs.at(run_index).sector_count;
+				internal::complete_sector_range(drive, pending_range.value(), sectors, successes, true);
+				pending_range.reset();
+				// The next run is read by the drive while the current run is being processed.
+				if (run_index + 1 < runs.size()) {
+					auto& next_run = runs.at(run_index + 1);
+					pending_range.emplace(drive.submit_absolute_sector_range(next_run.first_sector, next_run.sector_count));
 				}
-				if (success) {
-					extracted_sector_with_matching_data->counter += 1;
+				for (auto sector_offset = size_t(0); sector_offset < sector_count; sector_offset += 1) {
+					auto sector_index = range_first_sector + si_t(sector_offset);
+					internal::store_extracted_sector(candidate_stores, first_sector, sector_index, sectors.at(sector_offset), successes.at(sector_offset));
 				}
 			}
-			auto number_of_identical_copies = get_number_of_identical_copies(extracted_sectors_vector);
+			auto number_of_identical_copies = get_number_of_identical_copies(candidate_stores, min_copies);
 			OVERDRIVE_LOG("Got {} identical copies during pass {}", number_of_identical_copies, pass_index + 1);
 			if (pass_index + 1 >= min_passes && number_of_identical_copies >= max_copies) {
 				break;
 			}
 		}
-		auto number_of_identical_copies = get_number_of_identical_copies(extracted_sectors_vector);
+		auto number_of_identical_copies = get_number_of_identical_copies(candidate_stores, min_copies);
 		if (number_of_identical_copies < min_copies) {
 			OVERDRIVE_THROW(exceptions::InvalidValueException("number of identical copies", number_of_identical_copies, min_copies, max_copies));
 		}
-		return extracted_sectors_vector;
+		return candidate_stores;
+	}
+
+	auto get_extraction_window_length(
+		size_t max_passes,
+		std::optional<size_t> max_memory
+	) -> size_t {
+		if (!max_memory) {
+			return EXTRACTION_WINDOW_LENGTH;
+		}
+		// Every pass may add at most one distinct candidate to each sector in the window and the capacity of the candidates may grow to twice their number. Sectors read with C2 errors may also hold a merged sector.
+		auto sector_length = sizeof(CandidateStore) + sizeof(ExtractedSector) + sizeof(MergedSector) + 2 * max_passes * sizeof(SectorCandidate);
+		auto window_length = std::min(EXTRACTION_WINDOW_LENGTH, max_memory.value() / sector_length);
+		if (window_length < MIN_EXTRACTION_WINDOW_LENGTH) {
+			OVERDRIVE_LOG("The smallest window of {} sectors requires {} bytes which exceeds the memory limit of {} bytes!", MIN_EXTRACTION_WINDOW_LENGTH, MIN_EXTRACTION_WINDOW_LENGTH * sector_length, max_memory.value());
+			return MIN_EXTRACTION_WINDOW_LENGTH;
+		}
+		return window_length;
 	}
 
-	auto read_track(
+	auto stream_absolute_sector_range(
 		const drive::Drive& drive,
-		const disc::TrackInfo& track,
+		si_t first_sector,
+		si_t last_sector,
+		size_t min_passes,
+		size_t max_passes,
+		size_t max_retries,
+		size_t min_copies,
+		size_t max_copies,
+		bool_t rescue,
+		std::optional<size_t> max_memory,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t> {
+		auto bad_sector_indices = std::vector<size_t>();
+		auto window_length = get_extraction_window_length(max_passes, max_memory);
+		// The range is extracted in fixed windows so that memory use does not depend on the length of the range.
+		for (auto window_first_sector = first_sector; window_first_sector < last_sector; window_first_sector += si_t(window_length)) {
+			auto window_last_sector = std::min(last_sector, window_first_sector + si_t(window_length));
+			auto run_first_sector = window_first_sector;
+			while (run_first_sector < window_last_sector) {
+				if (journal != nullptr && journal->contains(run_first_sector)) {
+					auto extracted_sector = ExtractedSector();
+					auto entry = journal->read(run_first_sector, extracted_sector.sector_data, extracted_sector.subchannels_data);
+					extracted_sector.counter = entry.counter;
+					auto is_readable = entry.readability == journal::Readability::READABLE;
+					if (!is_readable) {
+						bad_sector_indices.push_back(run_first_sector);
+					}
+					sink(run_first_sector, extracted_sector, is_readable);
+					run_first_sector += 1;
+					continue;
+				}
+				// Sectors missing from the journal are extracted in contiguous runs.
+				auto run_last_sector = run_first_sector + 1;
+				while (run_last_sector < window_last_sector && (journal == nullptr || !journal->contains(run_last_sector))) {
+					run_last_sector += 1;
+				}
+				auto candidate_stores = read_absolute_sector_range(drive, run_first_sector, run_last_sector, min_passes, max_passes, max_retries, min_copies, max_copies, rescue);
+				internal::correct_subchannel_packs(candidate_stores, run_first_sector);
+				for (auto sector_offset = size_t(0); sector_offset < candidate_stores.size(); sector_offset += 1) {
+					auto sector_index = run_first_sector + si_t(sector_offset);
+					auto& extracted_sector = candidate_stores.at(sector_offset).get_leader();
+					auto is_readable = extracted_sector.counter > 0;
+					if (!is_readable) {
+						bad_sector_indices.push_back(sector_index);
+					}
+					if (journal != nullptr) {
+						journal->append(sector_index, extracted_sector.sector_data, extracted_sector.subchannels_data, is_readable, extracted_sector.counter);
+					}
+					sink(sector_index, extracted_sector, is_readable);
+				}
+				run_first_sector = run_last_sector;
+			}
+			if (journal != nullptr) {
+				journal->flush();
+			}
+		}
+		return bad_sector_indices;
+	}
+
+	auto detect_read_offset_correction(
+		const drive::Drive& drive,
+		const disc::DiscInfo& disc_info,
+		const accuraterip::Lookup& lookup,
 		const options::Options& options
-	) -> std::vector<std::vector<ExtractedSector>> {
+	) -> std::optional<si_t> {
+		auto tracks = std::vector<disc::TrackInfo>();
+		for (const auto& track : disc::get_disc_tracks(disc_info)) {
+			if (disc::is_audio_track(track.type) && lookup.create_checksum_computer(track)) {
+				tracks.push_back(track);
+			}
+		}
+		if (tracks.empty()) {
+			return std::optional<si_t>();
+		}
+		// The shortest track surrounded by other tracks is preferred since its padding can be read without reading outside of the audio session.
+		auto track = tracks.front();
+		for (auto track_index = size_t(1); track_index + 1 < tracks.size(); track_index += 1) {
+			if (track_index == 1 || tracks.at(track_index).length_sectors < track.length_sectors) {
+				track = tracks.at(track_index);
+			}
+		}
+		auto max_offset = accuraterip::MAX_DETECTED_READ_OFFSET_CORRECTION;
+		auto padding_sectors = size_t(idiv::ceil(max_offset, cdda::STEREO_SAMPLES_PER_SECTOR));
+		auto first_sector = si_t(track.first_sector_absolute) - si_t(padding_sectors);
+		auto last_sector = si_t(track.last_sector_absolute + padding_sectors);
+		OVERDRIVE_LOG("Detecting read offset correction using track number {} from {} to {}", track.number, first_sector, last_sector);
+		auto sector_data = std::vector<byte_t>((last_sector - first_sector) * cd::SECTOR_LENGTH);
+		stream_absolute_sector_range(
+			drive,
+			first_sector,
+			last_sector,
+			1,
+			1,
+			options.max_audio_retries,
+			0,
+			1,
+			false,
+			options.max_memory,
+			nullptr,
+			[&](si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+				if (is_readable) {
+					std::memcpy(&sector_data[(sector_index - first_sector) * cd::SECTOR_LENGTH], extracted_sector.sector_data, cd::SECTOR_LENGTH);
+				}
+			}
+		);
+		auto sample_data = &sector_data[(padding_sectors * cdda::STEREO_SAMPLES_PER_SECTOR - max_offset) * cdda::STEREO_SAMPLE_LENGTH];
+		auto checksums = lookup.compute_offset_checksums(track, sample_data, max_offset).value();
+		auto read_offset_correction = std::optional<si_t>();
+		auto max_confidence = size_t(0);
+		for (auto offset_index = size_t(0); offset_index < checksums.size(); offset_index += 1) {
+			auto confidence = lookup.get_checksum_confidence(track.number, checksums.at(offset_index));
+			if (!confidence) {
+				continue;
+			}
+			// Tracks such as digital silence produce identical checksums for several offsets and cannot be used.
+			if (read_offset_correction) {
+				OVERDRIVE_LOG("Track number {} matched AccurateRip at several read offset corrections", track.number);
+				return std::optional<si_t>();
+			}
+			read_offset_correction = si_t(offset_index) - si_t(max_offset);
+			max_confidence = confidence.value();
+		}
+		if (read_offset_correction) {
+			OVERDRIVE_LOG("Detected read offset correction [samples]: {} with confidence {}", read_offset_correction.value(), max_confidence);
+		} else {
+			// The v2 checksums cannot be computed incrementally across offsets which is why discs with v2 checksums only are not detected.
+			OVERDRIVE_LOG("Track number {} did not match any AccurateRip v1 checksum at any read offset correction", track.number);
+		}
+		return read_offset_correction;
+	}
+
+	auto stream_track(
+		const drive::Drive& drive,
+		const disc::TrackInfo& track,
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t> {
 		OVERDRIVE_LOG("Extracting track number {} containing {} sectors from {} to {}", track.number, track.length_sectors, track.first_sector_absolute, track.last_sector_absolute);
 		if (disc::is_data_track(track.type)) {
-			return read_data_track(drive, track, options);
+			return stream_data_track(drive, track, options, journal, sink);
 		} else {
-			return read_audio_track(drive, track, options);
+			return stream_audio_track(drive, track, options, lookup, journal, sink);
 		}
 	}
 
+	auto stream_tracks(
+		const drive::Drive& drive,
+		const std::vector<disc::TrackInfo>& tracks,
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const track_sink_t& sink
+	) -> std::vector<std::vector<size_t>> {
+		auto bad_sector_indices = std::vector<std::vector<size_t>>();
+		auto first_track_index = size_t(0);
+		while (first_track_index < tracks.size()) {
+			auto& first_track = tracks.at(first_track_index);
+			auto last_track_index = first_track_index + 1;
+			while (last_track_index < tracks.size()) {
+				auto& previous_track = tracks.at(last_track_index - 1);
+				auto& track = tracks.at(last_track_index);
+				if (track.first_sector_absolute != previous_track.last_sector_absolute || disc::is_data_track(track.type) != disc::is_data_track(first_track.type)) {
+					break;
+				}
+				last_track_index += 1;
+			}
+			auto run_tracks = std::vector<disc::TrackInfo>(tracks.begin() + first_track_index, tracks.begin() + last_track_index);
+			auto& last_track = run_tracks.back();
+			OVERDRIVE_LOG("Extracting track numbers {} to {} from {} to {}", first_track.number, last_track.number, first_track.first_sector_absolute, last_track.last_sector_absolute);
+			auto run_sink = [&](size_t track_index, si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable) -> void {
+				sink(first_track_index + track_index, sector_index, extracted_sector, is_readable);
+			};
+			auto run_bad_sector_indices = disc::is_data_track(first_track.type) ? stream_data_tracks(drive, run_tracks, options, journal, run_sink) : stream_audio_tracks(drive, run_tracks, options, lookup, journal, run_sink);
+			vector::append<std::vector<size_t>>(bad_sector_indices, run_bad_sector_indices);
+			first_track_index = last_track_index;
+		}
+		return bad_sector_indices;
+	}
+
 	auto append_sector_data(
-		const std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector,
+		const ExtractedSector& extracted_sector,
 		const std::string& path,
 		size_t sector_data_offset,
 		size_t sector_data_length,
 		std::FILE* handle,
 		bool_t write_subchannels
 	) -> void {
-		try {
-			OVERDRIVE_LOG("Saving track sector data to \"{}\"", path);
-			for (auto sector_index = size_t(0); sector_index < extracted_sectors_vector.size(); sector_index += 1) {
-				auto& extracted_sectors = extracted_sectors_vector.at(sector_index);
-				auto& extracted_sector = extracted_sectors.at(0);
-				if (std::fwrite(extracted_sector.sector_data + sector_data_offset, sector_data_length, 1, handle) != 1) {
-					OVERDRIVE_THROW(exceptions::IOWriteException(path));
-				}
-				if (write_subchannels) {
-					if (std::fwrite(extracted_sector.subchannels_data, sizeof(extracted_sector.subchannels_data), 1, handle) != 1) {
-						OVERDRIVE_THROW(exceptions::IOWriteException(path));
-					}
-				}
+		if (std::fwrite(extracted_sector.sector_data + sector_data_offset, sector_data_length, 1, handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOWriteException(path));
+		}
+		if (write_subchannels) {
+			if (std::fwrite(extracted_sector.subchannels_data, sizeof(extracted_sector.subchannels_data), 1, handle) != 1) {
+				OVERDRIVE_THROW(exceptions::IOWriteException(path));
 			}
-		} catch (...) {
-			std::fclose(handle);
-			throw;
 		}
 	}
 
@@ -292,18 +1071,6 @@ namespace archiver {
 		std::fclose(handle);
 	}
 
-	auto write_sector_data_to_file(
-		const std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector,
-		const std::string& path,
-		size_t sector_data_offset,
-		size_t sector_data_length,
-		bool_t write_subchannels
-	) -> void {
-		auto handle = open_handle(path);
-		append_sector_data(extracted_sectors_vector, path, sector_data_offset, sector_data_length, handle, write_subchannels);
-		close_handle(handle);
-	}
-
 	auto log_bad_sector_indices(
 		const drive::Drive& drive,
 		const disc::TrackInfo& track,
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <cstdio>
+#include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
+#include "accuraterip.h"
 #include "cd.h"
 #include "disc.h"
 #include "drive.h"
+#include "journal.h"
 #include "options.h"
 #include "shared.h"
 
@@ -14,6 +19,10 @@ namespace overdrive {
 namespace archiver {
 	using namespace shared;
 
+	const auto MAX_SURVEY_SKIP_SECTORS = size_t(4096);
+	const auto EXTRACTION_WINDOW_LENGTH = size_t(4096);
+	const auto MIN_EXTRACTION_WINDOW_LENGTH = size_t(64);
+
 	class ExtractedSector {
 		public:
 
@@ -37,24 +46,115 @@ namespace archiver {
 		protected:
 	};
 
-	auto read_audio_track(
+	class SectorCandidate {
+		public:
+
+		ui64_t hash;
+		size_t counter;
+
+		protected:
+	};
+
+	class MergedSector {
+		public:
+
+		byte_t sector_data[cd::SECTOR_LENGTH];
+		byte_t c2_data[cd::C2_LENGTH];
+		ui08_t votes[cd::SECTOR_LENGTH];
+
+		protected:
+	};
+
+	class CandidateStore {
+		public:
+
+		CandidateStore(
+		);
+
+		auto add(
+			const ExtractedSector& sector,
+			bool_t success,
+			bool_t verified
+		) -> void;
+
+		// Merges the bytes of the sector into the merged sector of the store. The C2 data of the returned sector flags the bytes that have not been read without C2 errors.
+		auto merge(
+			const ExtractedSector& sector
+		) -> ExtractedSector;
+
+		auto get_leader(
+		) const -> const ExtractedSector&;
+
+		auto get_leader(
+		) -> ExtractedSector&;
+
+		auto get_leader_counter(
+		) const -> size_t;
+
+		auto get_candidate_count(
+		) const -> size_t;
+
+		auto is_verified(
+		) const -> bool_t;
+
+		protected:
+
+		// Only the payload of the leading candidate is kept since a candidate can only overtake the leader when it is read again.
+		std::vector<SectorCandidate> candidates;
+		size_t leader_index;
+		ExtractedSector leader;
+		bool_t verified;
+		// The merged sector is only allocated for sectors read with C2 errors.
+		std::unique_ptr<MergedSector> merged_sector;
+	};
+
+	using sector_sink_t = std::function<void(si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable)>;
+	using track_sink_t = std::function<void(size_t track_index, si_t sector_index, const ExtractedSector& extracted_sector, bool_t is_readable)>;
+
+	auto stream_audio_track(
 		const drive::Drive& drive,
 		const disc::TrackInfo& track,
-		const options::Options& options
-	) -> std::vector<std::vector<ExtractedSector>>;
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t>;
 
-	auto read_data_track(
+	// The tracks must be contiguous.
+	auto stream_audio_tracks(
+		const drive::Drive& drive,
+		const std::vector<disc::TrackInfo>& tracks,
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const track_sink_t& sink
+	) -> std::vector<std::vector<size_t>>;
+
+	auto stream_data_track(
 		const drive::Drive& drive,
 		const disc::TrackInfo& track,
-		const options::Options& options
-	) -> std::vector<std::vector<ExtractedSector>>;
+		const options::Options& options,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t>;
 
+	// The tracks must be contiguous.
+	auto stream_data_tracks(
+		const drive::Drive& drive,
+		const std::vector<disc::TrackInfo>& tracks,
+		const options::Options& options,
+		pointer<journal::Journal> journal,
+		const track_sink_t& sink
+	) -> std::vector<std::vector<size_t>>;
+
+	// Verified sectors are counted as having at least verified_copies identical copies.
 	auto get_number_of_identical_copies(
-		std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector
+		const std::vector<CandidateStore>& candidate_stores,
+		size_t verified_copies
 	) -> size_t;
 
 	auto get_bad_sector_indices(
-		const std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector,
+		const std::vector<CandidateStore>& candidate_stores,
 		size_t first_sector
 	) -> std::vector<size_t>;
 
@@ -73,17 +173,59 @@ namespace archiver {
 		size_t max_passes,
 		size_t max_retries,
 		size_t min_copies,
-		size_t max_copies
-	) -> std::vector<std::vector<ExtractedSector>>;
+		size_t max_copies,
+		bool_t rescue
+	) -> std::vector<CandidateStore>;
+
+	auto get_extraction_window_length(
+		size_t max_passes,
+		std::optional<size_t> max_memory
+	) -> size_t;
 
-	auto read_track(
+	auto stream_absolute_sector_range(
 		const drive::Drive& drive,
-		const disc::TrackInfo& track,
+		si_t first_sector,
+		si_t last_sector,
+		size_t min_passes,
+		size_t max_passes,
+		size_t max_retries,
+		size_t min_copies,
+		size_t max_copies,
+		bool_t rescue,
+		std::optional<size_t> max_memory,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t>;
+
+	// Detects the read offset correction of the drive by matching an audio track against the v1 checksums of the database for every candidate offset.
+	auto detect_read_offset_correction(
+		const drive::Drive& drive,
+		const disc::DiscInfo& disc_info,
+		const accuraterip::Lookup& lookup,
 		const options::Options& options
-	) -> std::vector<std::vector<ExtractedSector>>;
+	) -> std::optional<si_t>;
+
+	auto stream_track(
+		const drive::Drive& drive,
+		const disc::TrackInfo& track,
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const sector_sink_t& sink
+	) -> std::vector<size_t>;
+
+	// Extracts every run of contiguous tracks of the same kind in a single sweep which avoids reading the sectors at the track boundaries twice. The bad sector indices are returned for each track.
+	auto stream_tracks(
+		const drive::Drive& drive,
+		const std::vector<disc::TrackInfo>& tracks,
+		const options::Options& options,
+		pointer<const accuraterip::Lookup> lookup,
+		pointer<journal::Journal> journal,
+		const track_sink_t& sink
+	) -> std::vector<std::vector<size_t>>;
 
 	auto append_sector_data(
-		const std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector,
+		const ExtractedSector& extracted_sector,
 		const std::string& path,
 		size_t sector_data_offset,
 		size_t sector_data_length,
@@ -99,14 +241,6 @@ namespace archiver {
 		std::FILE* handle
 	) -> void;
 
-	auto write_sector_data_to_file(
-		const std::vector<std::vector<ExtractedSector>>& extracted_sectors_vector,
-		const std::string& path,
-		size_t sector_data_offset,
-		size_t sector_data_length,
-		bool_t write_subchannels
-	) -> void;
-
 	auto log_bad_sector_indices(
 		const drive::Drive& drive,
 		const disc::TrackInfo& track,
@@ -1,5 +1,6 @@
 #include "bits.h"
 
+#include <algorithm>
 #include <bit>
 #include "exceptions.h"
 
@@ -7,6 +8,8 @@ namespace overdrive {
 namespace bits {
 	namespace internal {
 	namespace {
+		const auto MAX_CHUNK_WIDTH = size_t(32);
+
 		auto encode_value_using_exponential_golomb_coding(
 			size_t value,
 			size_t k,
@@ -15,7 +18,7 @@ namespace bits {
 			auto power = size_t(1) << k;
 			auto exponential_value = value + power;
 			auto width = sizeof(exponential_value) * 8 - std::countl_zero(exponential_value);
-			bitwriter.append_bits(0, width - 1 - k);
+			bitwriter.append_zeros(width - 1 - k);
 			bitwriter.append_bits(exponential_value, width);
 		}
 
@@ -24,19 +27,8 @@ namespace bits {
 			BitReader& bitreader
 		) -> size_t {
 			auto power = size_t(1) << k;
-			auto width = size_t(k + 1);
-			auto exponential_value = size_t(0);
-			while (true) {
-				exponential_value = bitreader.decode_bits(1);
-				if (exponential_value != 0) {
-					break;
-				}
-				width += 1;
-			}
-			width -= 1;
-			if (width > 0) {
-				exponential_value = (exponential_value << width) | bitreader.decode_bits(width);
-			}
+			auto width = k + bitreader.decode_unary();
+			auto exponential_value = (size_t(1) << width) | bitreader.decode_bits(width);
 			auto value = exponential_value - power;
 			return value;
 		}
@@ -49,9 +41,8 @@ namespace bits {
 	):
 		buffer(buffer),
 		offset(offset),
-		current_byte(0),
-		bits_in_byte(0),
-		mask(0b00000000)
+		accumulator(0),
+		bits_in_accumulator(0)
 	{
 
 	}
@@ -60,32 +51,68 @@ namespace bits {
 		size_t width
 	) -> size_t {
 		auto value = size_t(0);
-		for (auto bit = size_t(0); bit < width; bit += 1) {
-			if (this->bits_in_byte == 0) {
-				this->current_byte = this->buffer.at(offset);
-				this->bits_in_byte = 8;
-				this->offset += 1;
-				this->mask = 0b10000000;
+		while (width > 0) {
+			auto chunk_width = std::min<size_t>(width, internal::MAX_CHUNK_WIDTH);
+			if (this->bits_in_accumulator < chunk_width) {
+				this->refill();
+				if (this->bits_in_accumulator < chunk_width) {
+					OVERDRIVE_THROW(exceptions::MemoryReadException());
+				}
 			}
-			value = (value << 1) | ((this->current_byte & this->mask) ? 1 : 0);
-			this->bits_in_byte -= 1;
-			this->mask >>= 1;
+			value = (value << chunk_width) | size_t(this->accumulator >> (64 - chunk_width));
+			this->accumulator <<= chunk_width;
+			this->bits_in_accumulator -= chunk_width;
+			width -= chunk_width;
 		}
 		return value;
 	}
 
+	auto BitReader::decode_unary(
+	) -> size_t {
+		auto count = size_t(0);
+		while (true) {
+			if (this->bits_in_accumulator == 0) {
+				this->refill();
+				if (this->bits_in_accumulator == 0) {
+					OVERDRIVE_THROW(exceptions::MemoryReadException());
+				}
+			}
+			// Bits below the valid bits of the accumulator are always zero.
+			if (this->accumulator == 0) {
+				count += this->bits_in_accumulator;
+				this->bits_in_accumulator = 0;
+				continue;
+			}
+			auto zeros = size_t(std::countl_zero(this->accumulator));
+			count += zeros;
+			this->accumulator = zeros + 1 < 64 ? this->accumulator << (zeros + 1) : 0;
+			this->bits_in_accumulator -= zeros + 1;
+			return count;
+		}
+	}
+
 	auto BitReader::get_size(
 	) const -> size_t {
 		return this->buffer.size() * 8;
 	}
 
+	auto BitReader::refill(
+	) -> void {
+		while (this->bits_in_accumulator <= 56 && this->offset < this->buffer.size()) {
+			this->accumulator |= ui64_t(this->buffer[this->offset]) << (56 - this->bits_in_accumulator);
+			this->bits_in_accumulator += 8;
+			this->offset += 1;
+		}
+	}
+
 	BitWriter::BitWriter(
 		std::optional<size_t> max_size
 	):
 		buffer(std::vector<byte_t>()),
 		max_size(max_size),
-		current_byte(0),
-		bits_in_byte(0)
+		accumulator(0),
+		bits_in_accumulator(0),
+		size_exceeded(false)
 	{
 
 	}
@@ -94,45 +121,49 @@ namespace bits {
 		size_t value,
 		size_t width
 	) -> void {
-		if (width > 0) {
-			auto mask = (size_t(1) << (width - 1));
-			for (auto bit = size_t(0); bit < width; bit += 1) {
-				this->current_byte |= ((value & mask) ? 1 : 0) << (8 - bits_in_byte - 1);
-				this->bits_in_byte += 1;
-				if (this->bits_in_byte == 8) {
-					this->flush_bits();
-				}
-				mask >>= 1;
+		while (width > 0) {
+			auto chunk_width = std::min<size_t>(width, internal::MAX_CHUNK_WIDTH);
+			width -= chunk_width;
+			auto chunk = ui64_t(value >> width) & ((ui64_t(1) << chunk_width) - 1);
+			this->accumulator = (this->accumulator << chunk_width) | chunk;
+			this->bits_in_accumulator += chunk_width;
+			if (this->bits_in_accumulator >= internal::MAX_CHUNK_WIDTH) {
+				this->write_bytes();
 			}
 		}
 	}
 
-	auto BitWriter::append_one(
+	auto BitWriter::append_zeros(
+		size_t count
 	) -> void {
-		this->current_byte |= 1 << (8 - bits_in_byte - 1);
-		this->bits_in_byte += 1;
-		if (this->bits_in_byte == 8) {
-			this->flush_bits();
+		while (count > 0) {
+			auto chunk_width = std::min<size_t>(count, internal::MAX_CHUNK_WIDTH);
+			this->accumulator <<= chunk_width;
+			this->bits_in_accumulator += chunk_width;
+			if (this->bits_in_accumulator >= internal::MAX_CHUNK_WIDTH) {
+				this->write_bytes();
+			}
+			count -= chunk_width;
 		}
 	}
 
+	auto BitWriter::append_one(
+	) -> void {
+		this->append_bits(1, 1);
+	}
+
 	auto BitWriter::append_zero(
 	) -> void {
-		this->bits_in_byte += 1;
-		if (this->bits_in_byte == 8) {
-			this->flush_bits();
-		}
+		this->append_zeros(1);
 	}
 
 	auto BitWriter::flush_bits(
 	) -> void {
-		if (this->bits_in_byte > 0) {
-			this->buffer.push_back(this->current_byte);
-			this->current_byte = 0;
-			this->bits_in_byte = 0;
-			if (this->max_size && this->buffer.size() > this->max_size.value()) {
-				OVERDRIVE_THROW(exceptions::BitWriterSizeExceededError(this->max_size.value()));
-			}
+		this->write_bytes();
+		if (this->bits_in_accumulator > 0) {
+			this->accumulator <<= 8 - this->bits_in_accumulator;
+			this->bits_in_accumulator = 8;
+			this->write_bytes();
 		}
 	}
 
@@ -143,7 +174,25 @@ namespace bits {
 
 	auto BitWriter::get_size(
 	) const -> size_t {
-		return this->buffer.size() * 8 + this->bits_in_byte;
+		return this->buffer.size() * 8 + this->bits_in_accumulator;
+	}
+
+	auto BitWriter::is_size_exceeded(
+	) const -> bool_t {
+		return this->size_exceeded;
+	}
+
+	auto BitWriter::write_bytes(
+	) -> void {
+		while (this->bits_in_accumulator >= 8) {
+			this->bits_in_accumulator -= 8;
+			if (this->max_size && this->buffer.size() >= this->max_size.value()) {
+				this->size_exceeded = true;
+			} else {
+				this->buffer.push_back(byte_t(this->accumulator >> this->bits_in_accumulator));
+			}
+		}
+		this->accumulator &= (ui64_t(1) << this->bits_in_accumulator) - 1;
 	}
 
 	auto compress_data_using_exponential_golomb_coding(
@@ -153,11 +202,11 @@ namespace bits {
 		BitWriter& bitwriter
 	) -> void {
 		auto power = size_t(1) << k;
-		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
+		for (auto value_index = size_t(0); value_index < size && !bitwriter.is_size_exceeded(); value_index += 1) {
 			auto unsigned_value = values[value_index];
 			auto exponential_value = unsigned_value + power;
 			auto width = sizeof(exponential_value) * 8 - std::countl_zero(exponential_value);
-			bitwriter.append_bits(0, width - 1 - k);
+			bitwriter.append_zeros(width - 1 - k);
 			bitwriter.append_bits(exponential_value, width);
 		}
 	}
@@ -169,12 +218,12 @@ namespace bits {
 		BitWriter& bitwriter
 	) -> void {
 		auto power = size_t(1) << k;
-		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
+		for (auto value_index = size_t(0); value_index < size && !bitwriter.is_size_exceeded(); value_index += 1) {
 			auto value = values[value_index];
 			auto unsigned_value = ui16_t(value < 0 ? 0 - (value << 1) - 1 : value << 1);
 			auto exponential_value = unsigned_value + power;
 			auto width = sizeof(exponential_value) * 8 - std::countl_zero(exponential_value);
-			bitwriter.append_bits(0, width - 1 - k);
+			bitwriter.append_zeros(width - 1 - k);
 			bitwriter.append_bits(exponential_value, width);
 		}
 	}
@@ -186,15 +235,12 @@ namespace bits {
 		BitWriter& bitwriter
 	) -> void {
 		auto mask = size_t((1 << k) - 1);
-		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
+		for (auto value_index = size_t(0); value_index < size && !bitwriter.is_size_exceeded(); value_index += 1) {
 			auto unsigned_value = values[value_index];
 			auto quotient = size_t(unsigned_value >> k);
 			auto remainder = size_t(unsigned_value & mask);
-			for (auto bit_index = size_t(0); bit_index < quotient; bit_index += 1) {
-				bitwriter.append_zero();
-			}
-			bitwriter.append_one();
-			bitwriter.append_bits(remainder, k);
+			bitwriter.append_zeros(quotient);
+			bitwriter.append_bits((size_t(1) << k) | remainder, k + 1);
 		}
 	}
 
@@ -205,16 +251,29 @@ namespace bits {
 		BitWriter& bitwriter
 	) -> void {
 		auto mask = size_t((1 << k) - 1);
-		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
+		for (auto value_index = size_t(0); value_index < size && !bitwriter.is_size_exceeded(); value_index += 1) {
 			auto value = values[value_index];
 			auto unsigned_value = ui16_t(value < 0 ? 0 - (value << 1) - 1 : value << 1);
 			auto quotient = size_t(unsigned_value >> k);
 			auto remainder = size_t(unsigned_value & mask);
-			for (auto bit_index = size_t(0); bit_index < quotient; bit_index += 1) {
-				bitwriter.append_zero();
-			}
-			bitwriter.append_one();
-			bitwriter.append_bits(remainder, k);
+			bitwriter.append_zeros(quotient);
+			bitwriter.append_bits((size_t(1) << k) | remainder, k + 1);
+		}
+	}
+
+	auto compress_data_using_rice_coding(
+		const ui32_t* values,
+		size_t size,
+		size_t k,
+		BitWriter& bitwriter
+	) -> void {
+		auto mask = (size_t(1) << k) - 1;
+		for (auto value_index = size_t(0); value_index < size && !bitwriter.is_size_exceeded(); value_index += 1) {
+			auto unsigned_value = values[value_index];
+			auto quotient = size_t(unsigned_value >> k);
+			auto remainder = size_t(unsigned_value & mask);
+			bitwriter.append_zeros(quotient);
+			bitwriter.append_bits((size_t(1) << k) | remainder, k + 1);
 		}
 	}
 
@@ -224,7 +283,7 @@ namespace bits {
 		BitWriter& bitwriter
 	) -> void {
 		auto offset = size_t(0);
-		while (offset < size) {
+		while (offset < size && !bitwriter.is_size_exceeded()) {
 			auto raw_length = size_t(1);
 			for (auto byte_index = offset + 1; byte_index < size; byte_index += 1) {
 				if (bytes[byte_index] != bytes[byte_index - 1]) {
@@ -267,19 +326,8 @@ namespace bits {
 	) -> void {
 		auto power = size_t(1) << k;
 		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
-			auto width = size_t(k + 1);
-			auto exponential_value = size_t(0);
-			while (true) {
-				exponential_value = bitreader.decode_bits(1);
-				if (exponential_value != 0) {
-					break;
-				}
-				width += 1;
-			}
-			width -= 1;
-			if (width > 0) {
-				exponential_value = (exponential_value << width) | bitreader.decode_bits(width);
-			}
+			auto width = k + bitreader.decode_unary();
+			auto exponential_value = (size_t(1) << width) | bitreader.decode_bits(width);
 			auto unsigned_value = exponential_value - power;
 			values[value_index] = unsigned_value;
 		}
@@ -293,19 +341,8 @@ namespace bits {
 	) -> void {
 		auto power = size_t(1) << k;
 		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
-			auto width = size_t(k + 1);
-			auto exponential_value = size_t(0);
-			while (true) {
-				exponential_value = bitreader.decode_bits(1);
-				if (exponential_value != 0) {
-					break;
-				}
-				width += 1;
-			}
-			width -= 1;
-			if (width > 0) {
-				exponential_value = (exponential_value << width) | bitreader.decode_bits(width);
-			}
+			auto width = k + bitreader.decode_unary();
+			auto exponential_value = (size_t(1) << width) | bitreader.decode_bits(width);
 			auto unsigned_value = exponential_value - power;
 			auto value = si16_t((unsigned_value & 1) ? 0 - ((unsigned_value + 1) >> 1) : unsigned_value >> 1);
 			values[value_index] = value;
@@ -319,14 +356,7 @@ namespace bits {
 		BitReader& bitreader
 	) -> void {
 		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
-			auto quotient = size_t(0);
-			while (true) {
-				auto bit = bitreader.decode_bits(1);
-				if (bit != 0) {
-					break;
-				}
-				quotient += 1;
-			}
+			auto quotient = bitreader.decode_unary();
 			auto remainder = bitreader.decode_bits(k);
 			auto unsigned_value = (quotient << k) | remainder;
 			values[value_index] = unsigned_value;
@@ -339,14 +369,7 @@ namespace bits {
 		BitReader& bitreader
 	) -> void {
 		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
-			auto quotient = size_t(0);
-			while (true) {
-				auto bit = bitreader.decode_bits(1);
-				if (bit != 0) {
-					break;
-				}
-				quotient += 1;
-			}
+			auto quotient = bitreader.decode_unary();
 			auto remainder = bitreader.decode_bits(k);
 			auto unsigned_value = (quotient << k) | remainder;
 			auto value = si16_t((unsigned_value & 1) ? 0 - ((unsigned_value + 1) >> 1) : unsigned_value >> 1);
@@ -354,6 +377,20 @@ namespace bits {
 		}
 	}
 
+	auto decompress_data_using_rice_coding(
+		ui32_t* values,
+		size_t size,
+		size_t k,
+		BitReader& bitreader
+	) -> void {
+		for (auto value_index = size_t(0); value_index < size; value_index += 1) {
+			auto quotient = bitreader.decode_unary();
+			auto remainder = bitreader.decode_bits(k);
+			auto unsigned_value = (quotient << k) | remainder;
+			values[value_index] = unsigned_value;
+		}
+	}
+
 	auto decompress_data_using_rle_coding(
 		byte_t* bytes,
 		size_t size,
@@ -8,6 +8,7 @@ namespace overdrive {
 namespace bits {
 	using namespace shared;
 
+	// Bits are consumed from the most significant end of a 64-bit accumulator that is refilled a byte at a time.
 	class BitReader {
 		public:
 
@@ -23,18 +24,26 @@ namespace bits {
 			size_t width
 		) -> size_t;
 
+		// Decodes the number of zero bits preceding the next one bit and consumes the one bit.
+		auto decode_unary(
+		) -> size_t;
+
 		auto get_size(
 		) const -> size_t;
 
 		protected:
 
+		auto refill(
+		) -> void;
+
 		const std::vector<byte_t>& buffer;
 		size_t offset;
-		byte_t current_byte;
-		size_t bits_in_byte;
-		size_t mask;
+		ui64_t accumulator;
+		size_t bits_in_accumulator;
 	};
 
+	// Bits are collected in the least significant end of a 64-bit accumulator and written to the buffer as whole bytes.
+	// Bytes that would make the buffer exceed the maximum size are discarded and the writer is marked as exceeded.
 	class BitWriter {
 		public:
 
@@ -50,6 +59,10 @@ namespace bits {
 			size_t width
 		) -> void;
 
+		auto append_zeros(
+			size_t count
+		) -> void;
+
 		auto append_one(
 		) -> void;
 
@@ -65,12 +78,19 @@ namespace bits {
 		auto get_size(
 		) const -> size_t;
 
+		auto is_size_exceeded(
+		) const -> bool_t;
+
 		protected:
 
+		auto write_bytes(
+		) -> void;
+
 		std::vector<byte_t> buffer;
 		std::optional<size_t> max_size;
-		byte_t current_byte;
-		size_t bits_in_byte;
+		ui64_t accumulator;
+		size_t bits_in_accumulator;
+		bool_t size_exceeded;
 	};
 
 	auto compress_data_using_exponential_golomb_coding(
@@ -101,6 +121,13 @@ namespace bits {
 		BitWriter& bitwriter
 	) -> void;
 
+	auto compress_data_using_rice_coding(
+		const ui32_t* values,
+		size_t size,
+		size_t k,
+		BitWriter& bitwriter
+	) -> void;
+
 	auto compress_data_using_rle_coding(
 		const byte_t* bytes,
 		size_t size,
@@ -135,6 +162,13 @@ namespace bits {
 		BitReader& bitreader
 	) -> void;
 
+	auto decompress_data_using_rice_coding(
+		ui32_t* values,
+		size_t size,
+		size_t k,
+		BitReader& bitreader
+	) -> void;
+
 	auto decompress_data_using_rle_coding(
 		byte_t* bytes,
 		size_t size,
@@ -1,5 +1,8 @@
 #include "cd.h"
 
+#include <bit>
+#include <cstring>
+#include <optional>
 #include "byteswap.h"
 #include "crc.h"
 #include "exceptions.h"
@@ -7,6 +10,311 @@
 
 namespace overdrive {
 namespace cd {
+	namespace internal {
+	namespace {
+		const auto SUBCHANNEL_Q_BIT_COUNT = size_t(SUBCHANNEL_LENGTH * 8);
+		const auto SUBCHANNEL_Q_CRC_BIT_OFFSET = size_t(offsetof(SubchannelQ, crc_be) * 8);
+		const auto SUBCHANNEL_Q_SYNDROME_COUNT = size_t(65536);
+		const auto SECUROM_CRC_XOR = ui16_t(0x8001);
+		const auto SECUROM_FIRST_BIT_INDEX_START = size_t(24);
+		const auto SECUROM_FIRST_BIT_INDEX_END = size_t(48);
+		const auto SECUROM_SECOND_BIT_INDEX_START = size_t(56);
+		const auto SECUROM_SECOND_BIT_INDEX_END = size_t(80);
+		const auto NO_ERROR_PATTERN = byte_t(0xFF);
+		const auto SECUROM_ERROR_PATTERN = byte_t(0xFE);
+
+		auto SUBCHANNEL_Q_BIT_ERROR_SYNDROMES() -> constant<array<SUBCHANNEL_Q_BIT_COUNT, ui16_t>>& {
+			static auto initialized = false;
+			static ui16_t table[SUBCHANNEL_Q_BIT_COUNT];
+			if (!initialized) {
+				for (auto bit_index = size_t(0); bit_index < SUBCHANNEL_Q_BIT_COUNT; bit_index += 1) {
+					if (bit_index < SUBCHANNEL_Q_CRC_BIT_OFFSET) {
+						table[bit_index] = crc::compute_crc16_bit_error_syndrome(offsetof(SubchannelQ, crc_be), bit_index);
+					} else {
+						table[bit_index] = ui16_t(0x8000 >> (bit_index - SUBCHANNEL_Q_CRC_BIT_OFFSET));
+					}
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		// Maps the syndrome of a Q subchannel to the bit that corrects it or to NO_ERROR_PATTERN.
+		auto SUBCHANNEL_Q_SINGLE_BIT_ERROR_TABLE() -> constant<array<SUBCHANNEL_Q_SYNDROME_COUNT, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[SUBCHANNEL_Q_SYNDROME_COUNT];
+			if (!initialized) {
+				auto& syndromes = SUBCHANNEL_Q_BIT_ERROR_SYNDROMES();
+				for (auto syndrome = size_t(0); syndrome < SUBCHANNEL_Q_SYNDROME_COUNT; syndrome += 1) {
+					table[syndrome] = NO_ERROR_PATTERN;
+				}
+				for (auto bit_index = SUBCHANNEL_Q_BIT_COUNT; bit_index > 0; bit_index -= 1) {
+					table[syndromes[bit_index - 1]] = byte_t(bit_index - 1);
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		// Maps the syndrome of a Q subchannel, adjusted for the SecuROM CRC XOR, to SECUROM_ERROR_PATTERN when only the deliberate SecuROM errors are present, to the bit that corrects an additional single bit error or to NO_ERROR_PATTERN.
+		auto SUBCHANNEL_Q_SECUROM_ERROR_TABLE() -> constant<array<SUBCHANNEL_Q_SYNDROME_COUNT, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[SUBCHANNEL_Q_SYNDROME_COUNT];
+			if (!initialized) {
+				auto& syndromes = SUBCHANNEL_Q_BIT_ERROR_SYNDROMES();
+				for (auto syndrome = size_t(0); syndrome < SUBCHANNEL_Q_SYNDROME_COUNT; syndrome += 1) {
+					table[syndrome] = NO_ERROR_PATTERN;
+				}
+				for (auto bit_index = SUBCHANNEL_Q_BIT_COUNT; bit_index > 0; bit_index -= 1) {
+					for (auto bit_index_0 = SECUROM_FIRST_BIT_INDEX_START; bit_index_0 < SECUROM_FIRST_BIT_INDEX_END; bit_index_0 += 1) {
+						for (auto bit_index_1 = SECUROM_SECOND_BIT_INDEX_START; bit_index_1 < SECUROM_SECOND_BIT_INDEX_END; bit_index_1 += 1) {
+							table[syndromes[bit_index_0] ^ syndromes[bit_index_1] ^ syndromes[bit_index - 1]] = byte_t(bit_index - 1);
+						}
+					}
+				}
+				for (auto bit_index_0 = SECUROM_FIRST_BIT_INDEX_START; bit_index_0 < SECUROM_FIRST_BIT_INDEX_END; bit_index_0 += 1) {
+					for (auto bit_index_1 = SECUROM_SECOND_BIT_INDEX_START; bit_index_1 < SECUROM_SECOND_BIT_INDEX_END; bit_index_1 += 1) {
+						table[syndromes[bit_index_0] ^ syndromes[bit_index_1]] = SECUROM_ERROR_PATTERN;
+					}
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		// This is the truncated version of P(X) = X^6 + X + 1 used for the R-W packs.
+		const auto TRUNCATED_6BIT_POLYNOMIAL = ui08_t(0x03);
+		const auto GF64_ORDER = size_t(63);
+		const auto SUBCHANNEL_PACK_SYMBOL_MASK = byte_t(0x3F);
+
+		auto GF64_EXP_TABLE() -> constant<array<GF64_ORDER * 2, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[GF64_ORDER * 2];
+			if (!initialized) {
+				auto value = ui08_t(1);
+				for (auto exponent = size_t(0); exponent < GF64_ORDER * 2; exponent += 1) {
+					table[exponent] = value;
+					auto wont_overflow = (value & 0x20) == 0;
+					if (wont_overflow) {
+						value = (value << 1);
+					} else {
+						value = ((value << 1) & 0x3F) ^ TRUNCATED_6BIT_POLYNOMIAL;
+					}
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		auto GF64_LOG_TABLE() -> constant<array<GF64_ORDER + 1, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[GF64_ORDER + 1];
+			if (!initialized) {
+				auto& exp_table = GF64_EXP_TABLE();
+				table[0] = 0;
+				for (auto exponent = size_t(0); exponent < GF64_ORDER; exponent += 1) {
+					table[exp_table[exponent]] = byte_t(exponent);
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		auto gf64_multiply(
+			byte_t a,
+			byte_t b
+		) -> byte_t {
+			if (a == 0 || b == 0) {
+				return 0;
+			}
+			return GF64_EXP_TABLE()[GF64_LOG_TABLE()[a] + GF64_LOG_TABLE()[b]];
+		}
+
+		auto gf64_divide(
+			byte_t a,
+			byte_t b
+		) -> byte_t {
+			if (a == 0) {
+				return 0;
+			}
+			return GF64_EXP_TABLE()[GF64_LOG_TABLE()[a] + GF64_ORDER - GF64_LOG_TABLE()[b]];
+		}
+
+		auto gf64_power(
+			size_t exponent
+		) -> byte_t {
+			return GF64_EXP_TABLE()[exponent % GF64_ORDER];
+		}
+
+		// The syndromes are computed for the roots a^0 through a^(count - 1) with the first symbol as the highest order coefficient.
+		auto compute_reed_solomon_syndromes(
+			const byte_t* symbols,
+			size_t length,
+			byte_t* syndromes,
+			size_t count
+		) -> bool_t {
+			auto has_errors = false;
+			for (auto syndrome_index = size_t(0); syndrome_index < count; syndrome_index += 1) {
+				auto syndrome = byte_t(0);
+				auto root = gf64_power(syndrome_index);
+				for (auto symbol_index = size_t(0); symbol_index < length; symbol_index += 1) {
+					syndrome = gf64_multiply(syndrome, root) ^ symbols[symbol_index];
+				}
+				syndromes[syndrome_index] = syndrome;
+				has_errors = has_errors || syndrome != 0;
+			}
+			return has_errors;
+		}
+
+		auto get_reed_solomon_symbol_index(
+			byte_t locator,
+			size_t length
+		) -> std::optional<size_t> {
+			auto position = size_t(GF64_LOG_TABLE()[locator]);
+			if (position >= length) {
+				return std::optional<size_t>();
+			}
+			return length - 1 - position;
+		}
+
+		// Corrects up to one symbol error using two syndromes.
+		auto correct_reed_solomon_single_error(
+			byte_t* symbols,
+			size_t length
+		) -> bool_t {
+			byte_t syndromes[2];
+			if (!compute_reed_solomon_syndromes(symbols, length, syndromes, 2)) {
+				return true;
+			}
+			if (syndromes[0] == 0 || syndromes[1] == 0) {
+				return false;
+			}
+			auto symbol_index = get_reed_solomon_symbol_index(gf64_divide(syndromes[1], syndromes[0]), length);
+			if (!symbol_index) {
+				return false;
+			}
+			symbols[symbol_index.value()] ^= syndromes[0];
+			return true;
+		}
+
+		// Corrects up to two symbol errors using four syndromes.
+		auto correct_reed_solomon_double_error(
+			byte_t* symbols,
+			size_t length
+		) -> bool_t {
+			byte_t syndromes[4];
+			if (!compute_reed_solomon_syndromes(symbols, length, syndromes, 4)) {
+				return true;
+			}
+			if (syndromes[0] != 0 && syndromes[1] != 0) {
+				auto locator = gf64_divide(syndromes[1], syndromes[0]);
+				if (gf64_multiply(syndromes[1], locator) == syndromes[2] && gf64_multiply(syndromes[2], locator) == syndromes[3]) {
+					auto symbol_index = get_reed_solomon_symbol_index(locator, length);
+					if (!symbol_index) {
+						return false;
+					}
+					symbols[symbol_index.value()] ^= syndromes[0];
+					return true;
+				}
+			}
+			auto determinant = byte_t(gf64_multiply(syndromes[1], syndromes[1]) ^ gf64_multiply(syndromes[0], syndromes[2]));
+			if (determinant == 0) {
+				return false;
+			}
+			auto sigma_1 = gf64_divide(gf64_multiply(syndromes[1], syndromes[2]) ^ gf64_multiply(syndromes[0], syndromes[3]), determinant);
+			auto sigma_2 = gf64_divide(gf64_multiply(syndromes[1], syndromes[3]) ^ gf64_multiply(syndromes[2], syndromes[2]), determinant);
+			byte_t locators[2];
+			auto locator_count = size_t(0);
+			for (auto position = size_t(0); position < length; position += 1) {
+				auto locator = gf64_power(position);
+				if ((gf64_multiply(locator, locator) ^ gf64_multiply(sigma_1, locator) ^ sigma_2) == 0) {
+					if (locator_count == 2) {
+						return false;
+					}
+					locators[locator_count] = locator;
+					locator_count += 1;
+				}
+			}
+			if (locator_count != 2) {
+				return false;
+			}
+			auto magnitude_0 = gf64_divide(syndromes[1] ^ gf64_multiply(syndromes[0], locators[1]), locators[0] ^ locators[1]);
+			auto magnitude_1 = byte_t(syndromes[0] ^ magnitude_0);
+			symbols[get_reed_solomon_symbol_index(locators[0], length).value()] ^= magnitude_0;
+			symbols[get_reed_solomon_symbol_index(locators[1], length).value()] ^= magnitude_1;
+			return true;
+		}
+
+		auto is_valid_subchannel_pack(
+			const array<SUBCHANNEL_PACK_LENGTH, byte_t>& pack
+		) -> bool_t {
+			byte_t q_syndromes[SUBCHANNEL_PACK_Q_PARITY_LENGTH];
+			byte_t p_syndromes[SUBCHANNEL_PACK_P_PARITY_LENGTH];
+			if (compute_reed_solomon_syndromes(pack, SUBCHANNEL_PACK_Q_LENGTH, q_syndromes, SUBCHANNEL_PACK_Q_PARITY_LENGTH)) {
+				return false;
+			}
+			if (compute_reed_solomon_syndromes(pack, SUBCHANNEL_PACK_LENGTH, p_syndromes, SUBCHANNEL_PACK_P_PARITY_LENGTH)) {
+				return false;
+			}
+			return true;
+		}
+
+		// Symbols 1, 2 and 3 of each pack are swapped with symbols 18, 5 and 23 before the interleaving.
+		auto get_subchannel_pack_symbol_index(
+			size_t symbol_index
+		) -> size_t {
+			if (symbol_index == 1) {
+				return 18;
+			}
+			if (symbol_index == 18) {
+				return 1;
+			}
+			if (symbol_index == 2) {
+				return 5;
+			}
+			if (symbol_index == 5) {
+				return 2;
+			}
+			if (symbol_index == 3) {
+				return 23;
+			}
+			if (symbol_index == 23) {
+				return 3;
+			}
+			return symbol_index;
+		}
+
+		// Symbol n of a pack is delayed by (n mod 8) packs.
+		auto get_interleaved_subchannel_pack_symbol(
+			const std::vector<pointer<array<SUBCHANNELS_LENGTH, byte_t>>>& subchannels_data,
+			size_t pack_index,
+			size_t symbol_index
+		) -> byte_t& {
+			auto interleaved_pack_index = pack_index + (symbol_index % SUBCHANNEL_PACK_INTERLEAVE_LENGTH);
+			auto sector_offset = interleaved_pack_index / SUBCHANNEL_PACKS_PER_SECTOR;
+			auto byte_index = (interleaved_pack_index % SUBCHANNEL_PACKS_PER_SECTOR) * SUBCHANNEL_PACK_LENGTH + symbol_index;
+			return (*subchannels_data.at(sector_offset))[byte_index];
+		}
+
+		auto count_set_bits(
+			const Subchannel& subchannel
+		) -> size_t {
+			auto count = size_t(0);
+			for (auto byte_index = size_t(0); byte_index < SUBCHANNEL_LENGTH; byte_index += 1) {
+				count += std::popcount(subchannel.data[byte_index]);
+			}
+			return count;
+		}
+
+		auto compute_subchannel_q_syndrome(
+			const SubchannelQ& q
+		) -> ui16_t {
+			auto syndrome = ui16_t(compute_subchannel_q_crc(q) ^ byteswap::byteswap16_on_little_endian_systems(q.crc_be));
+			return syndrome;
+		}
+	}
+	}
+
 	auto get_absolute_sector_index(
 		si_t relative_sector_index
 	) -> si_t {
@@ -165,27 +473,14 @@ namespace cd {
 	}
 
 	auto is_securom_sector(
-		Subchannel& subchannel,
+		const Subchannel& subchannel,
 		si_t sector_index
 	) -> bool_t {
-		auto& q = *reinterpret_cast<SubchannelQ*>(subchannel.data);
-		for (auto bit_index_0 = size_t(24); bit_index_0 < size_t(48); bit_index_0 += 1) {
-			auto& byte_0 = subchannel.data[bit_index_0 >> 3];
-			auto bit_mask_0 = 1 << (7 - (bit_index_0 & 7));
-			byte_0 ^= bit_mask_0;
-			for (auto bit_index_1 = size_t(56); bit_index_1 < size_t(80); bit_index_1 += 1) {
-				auto& byte_1 = subchannel.data[bit_index_1 >> 3];
-				auto bit_mask_1 = 1 << (7 - (bit_index_1 & 7));
-				byte_1 ^= bit_mask_1;
-				if ((compute_subchannel_q_crc(q) ^ 0x8001) == byteswap::byteswap16_on_little_endian_systems(q.crc_be)) {
-					OVERDRIVE_LOG("Detected SecuROM sector at {}", sector_index);
-					byte_1 ^= bit_mask_1;
-					byte_0 ^= bit_mask_0;
-					return true;
-				}
-				byte_1 ^= bit_mask_1;
-			}
-			byte_0 ^= bit_mask_0;
+		auto& q = *reinterpret_cast<const SubchannelQ*>(subchannel.data);
+		auto syndrome = internal::compute_subchannel_q_syndrome(q);
+		if (internal::SUBCHANNEL_Q_SECUROM_ERROR_TABLE()[syndrome ^ internal::SECUROM_CRC_XOR] == internal::SECUROM_ERROR_PATTERN) {
+			OVERDRIVE_LOG("Detected SecuROM sector at {}", sector_index);
+			return true;
 		}
 		return false;
 	}
@@ -195,66 +490,26 @@ namespace cd {
 		si_t sector_index,
 		ch08_t name
 	) -> void {
-		if (memory::test(subchannel.data, sizeof(subchannel.data), 0b00000000)) {
-			return;
+		(void)sector_index;
+		(void)name;
+		// Channels with more than two bits set carry R-W packs that are corrected by the pack decoder.
+		if (internal::count_set_bits(subchannel) <= 2) {
+			std::memset(subchannel.data, 0b00000000, sizeof(subchannel.data));
 		}
-		for (auto bit_index_0 = size_t(0); bit_index_0 < SUBCHANNEL_LENGTH * 8; bit_index_0 += 1) {
-			auto& byte_0 = subchannel.data[bit_index_0 >> 3];
-			auto bit_mask_0 = 1 << (7 - (bit_index_0 & 7));
-			byte_0 ^= bit_mask_0;
-			if (memory::test(subchannel.data, sizeof(subchannel.data), 0b00000000)) {
-				return;
-			}
-			byte_0 ^= bit_mask_0;
-		}
-		for (auto bit_index_0 = size_t(0); bit_index_0 < SUBCHANNEL_LENGTH * 8; bit_index_0 += 1) {
-			auto& byte_0 = subchannel.data[bit_index_0 >> 3];
-			auto bit_mask_0 = 1 << (7 - (bit_index_0 & 7));
-			byte_0 ^= bit_mask_0;
-			for (auto bit_index_1 = bit_index_0 + 1; bit_index_1 < SUBCHANNEL_LENGTH * 8; bit_index_1 += 1) {
-				auto& byte_1 = subchannel.data[bit_index_1 >> 3];
-				auto bit_mask_1 = 1 << (7 - (bit_index_1 & 7));
-				byte_1 ^= bit_mask_1;
-				if (memory::test(subchannel.data, sizeof(subchannel.data), 0b00000000)) {
-					return;
-				}
-				byte_1 ^= bit_mask_1;
-			}
-			byte_0 ^= bit_mask_0;
-		}
-		OVERDRIVE_LOG("Subchannel {} correction failed for sector {}!", name, sector_index);
 	}
 
 	auto correct_subchannel_p(
 		Subchannel& subchannel,
 		si_t sector_index
 	) -> void {
-		if (memory::test(subchannel.data, sizeof(subchannel.data), 0b00000000) || memory::test(subchannel.data, sizeof(subchannel.data), 0b11111111)) {
+		auto bit_count = internal::count_set_bits(subchannel);
+		if (bit_count <= 2) {
+			std::memset(subchannel.data, 0b00000000, sizeof(subchannel.data));
 			return;
 		}
-		for (auto bit_index_0 = size_t(0); bit_index_0 < SUBCHANNEL_LENGTH * 8; bit_index_0 += 1) {
-			auto& byte_0 = subchannel.data[bit_index_0 >> 3];
-			auto bit_mask_0 = 1 << (7 - (bit_index_0 & 7));
-			byte_0 ^= bit_mask_0;
-			if (memory::test(subchannel.data, sizeof(subchannel.data), 0b00000000) || memory::test(subchannel.data, sizeof(subchannel.data), 0b11111111)) {
-				return;
-			}
-			byte_0 ^= bit_mask_0;
-		}
-		for (auto bit_index_0 = size_t(0); bit_index_0 < SUBCHANNEL_LENGTH * 8; bit_index_0 += 1) {
-			auto& byte_0 = subchannel.data[bit_index_0 >> 3];
-			auto bit_mask_0 = 1 << (7 - (bit_index_0 & 7));
-			byte_0 ^= bit_mask_0;
-			for (auto bit_index_1 = bit_index_0 + 1; bit_index_1 < SUBCHANNEL_LENGTH * 8; bit_index_1 += 1) {
-				auto& byte_1 = subchannel.data[bit_index_1 >> 3];
-				auto bit_mask_1 = 1 << (7 - (bit_index_1 & 7));
-				byte_1 ^= bit_mask_1;
-				if (memory::test(subchannel.data, sizeof(subchannel.data), 0b00000000) || memory::test(subchannel.data, sizeof(subchannel.data), 0b11111111)) {
-					return;
-				}
-				byte_1 ^= bit_mask_1;
-			}
-			byte_0 ^= bit_mask_0;
+		if (bit_count >= SUBCHANNEL_LENGTH * 8 - 2) {
+			std::memset(subchannel.data, 0b11111111, sizeof(subchannel.data));
+			return;
 		}
 		OVERDRIVE_LOG("Subchannel P correction failed for sector {}!", sector_index);
 	}
@@ -264,29 +519,23 @@ namespace cd {
 		si_t sector_index
 	) -> void {
 		auto& q = *reinterpret_cast<SubchannelQ*>(subchannel.data);
-		if (compute_subchannel_q_crc(q) == byteswap::byteswap16_on_little_endian_systems(q.crc_be)) {
+		auto syndrome = internal::compute_subchannel_q_syndrome(q);
+		if (syndrome == 0) {
 			return;
 		}
-		for (auto bit_index_0 = size_t(0); bit_index_0 < SUBCHANNEL_LENGTH * 8; bit_index_0 += 1) {
-			auto& byte_0 = subchannel.data[bit_index_0 >> 3];
-			auto bit_mask_0 = 1 << (7 - (bit_index_0 & 7));
-			byte_0 ^= bit_mask_0;
-			if (compute_subchannel_q_crc(q) == byteswap::byteswap16_on_little_endian_systems(q.crc_be)) {
-				return;
-			}
-			byte_0 ^= bit_mask_0;
+		auto bit_index = internal::SUBCHANNEL_Q_SINGLE_BIT_ERROR_TABLE()[syndrome];
+		if (bit_index != internal::NO_ERROR_PATTERN) {
+			subchannel.data[bit_index >> 3] ^= 1 << (7 - (bit_index & 7));
+			return;
 		}
 		if (is_securom_sector(subchannel, sector_index)) {
 			return;
 		}
-		for (auto bit_index_0 = size_t(0); bit_index_0 < SUBCHANNEL_LENGTH * 8; bit_index_0 += 1) {
-			auto& byte_0 = subchannel.data[bit_index_0 >> 3];
-			auto bit_mask_0 = 1 << (7 - (bit_index_0 & 7));
-			byte_0 ^= bit_mask_0;
-			if (is_securom_sector(subchannel, sector_index)) {
-				return;
-			}
-			byte_0 ^= bit_mask_0;
+		bit_index = internal::SUBCHANNEL_Q_SECUROM_ERROR_TABLE()[syndrome ^ internal::SECUROM_CRC_XOR];
+		if (bit_index != internal::NO_ERROR_PATTERN) {
+			subchannel.data[bit_index >> 3] ^= 1 << (7 - (bit_index & 7));
+			OVERDRIVE_LOG("Detected SecuROM sector at {}", sector_index);
+			return;
 		}
 		OVERDRIVE_LOG("Subchannel Q correction failed for sector {}!", sector_index);
 	}
@@ -346,5 +595,51 @@ namespace cd {
 		correct_subchannel_v(subchannels.channels[SUBCHANNEL_V_INDEX], sector_index);
 		correct_subchannel_w(subchannels.channels[SUBCHANNEL_W_INDEX], sector_index);
 	}
+	auto correct_subchannel_pack(
+		array<SUBCHANNEL_PACK_LENGTH, byte_t>& pack
+	) -> bool_t {
+		if (internal::is_valid_subchannel_pack(pack)) {
+			return true;
+		}
+		// The Q parity only protects the first symbols so both decoding orders are attempted.
+		byte_t corrected[SUBCHANNEL_PACK_LENGTH];
+		std::memcpy(corrected, pack, sizeof(corrected));
+		internal::correct_reed_solomon_double_error(corrected, SUBCHANNEL_PACK_LENGTH);
+		if (!internal::is_valid_subchannel_pack(corrected)) {
+			std::memcpy(corrected, pack, sizeof(corrected));
+			internal::correct_reed_solomon_single_error(corrected, SUBCHANNEL_PACK_Q_LENGTH);
+			internal::correct_reed_solomon_double_error(corrected, SUBCHANNEL_PACK_LENGTH);
+			if (!internal::is_valid_subchannel_pack(corrected)) {
+				return false;
+			}
+		}
+		std::memcpy(pack, corrected, sizeof(corrected));
+		return true;
+	}
+
+	auto correct_subchannel_packs(
+		const std::vector<pointer<array<SUBCHANNELS_LENGTH, byte_t>>>& subchannels_data,
+		si_t first_sector_index
+	) -> void {
+		auto pack_count = subchannels_data.size() * SUBCHANNEL_PACKS_PER_SECTOR;
+		for (auto pack_index = size_t(0); pack_index + SUBCHANNEL_PACK_INTERLEAVE_LENGTH <= pack_count; pack_index += 1) {
+			byte_t pack[SUBCHANNEL_PACK_LENGTH];
+			for (auto symbol_index = size_t(0); symbol_index < SUBCHANNEL_PACK_LENGTH; symbol_index += 1) {
+				auto& byte = internal::get_interleaved_subchannel_pack_symbol(subchannels_data, pack_index, symbol_index);
+				pack[internal::get_subchannel_pack_symbol_index(symbol_index)] = byte & internal::SUBCHANNEL_PACK_SYMBOL_MASK;
+			}
+			if (internal::is_valid_subchannel_pack(pack)) {
+				continue;
+			}
+			if (!correct_subchannel_pack(pack)) {
+				OVERDRIVE_LOG("Subchannel pack correction failed for pack {} of sector {}!", pack_index % SUBCHANNEL_PACKS_PER_SECTOR, first_sector_index + si_t(pack_index / SUBCHANNEL_PACKS_PER_SECTOR));
+				continue;
+			}
+			for (auto symbol_index = size_t(0); symbol_index < SUBCHANNEL_PACK_LENGTH; symbol_index += 1) {
+				auto& byte = internal::get_interleaved_subchannel_pack_symbol(subchannels_data, pack_index, symbol_index);
+				byte = (byte & ~internal::SUBCHANNEL_PACK_SYMBOL_MASK) | pack[internal::get_subchannel_pack_symbol_index(symbol_index)];
+			}
+		}
+	}
 }
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include "shared.h"
 
 namespace overdrive {
@@ -23,6 +24,12 @@ namespace cd {
 	const auto SUBCHANNEL_W_INDEX = size_t(7);
 	const auto SUBCHANNELS_LENGTH = size_t(SUBCHANNEL_COUNT * SUBCHANNEL_LENGTH);
 	const auto C2_LENGTH = size_t(SECTOR_LENGTH / 8);
+	const auto SUBCHANNEL_PACK_LENGTH = size_t(24);
+	const auto SUBCHANNEL_PACKS_PER_SECTOR = size_t(SUBCHANNELS_LENGTH / SUBCHANNEL_PACK_LENGTH);
+	const auto SUBCHANNEL_PACK_INTERLEAVE_LENGTH = size_t(8);
+	const auto SUBCHANNEL_PACK_Q_LENGTH = size_t(4);
+	const auto SUBCHANNEL_PACK_Q_PARITY_LENGTH = size_t(2);
+	const auto SUBCHANNEL_PACK_P_PARITY_LENGTH = size_t(4);
 	const auto PACKET_DATA_LENGTH = size_t(24);
 	const auto PACKET_CIRC_LENGTH = size_t(8);
 	const auto PACKET_SUBCHANNELS_LENGTH = size_t(1);
@@ -196,7 +203,7 @@ namespace cd {
 	) -> ui16_t;
 
 	auto is_securom_sector(
-		Subchannel& subchannel,
+		const Subchannel& subchannel,
 		si_t sector_index
 	) -> bool_t;
 
@@ -250,5 +257,15 @@ namespace cd {
 		Subchannels& subchannels,
 		si_t sector_index
 	) -> void;
+
+	auto correct_subchannel_pack(
+		array<SUBCHANNEL_PACK_LENGTH, byte_t>& pack
+	) -> bool_t;
+
+	// The R-W packs are interleaved over consecutive sectors so packs extending beyond the last sector are left as is.
+	auto correct_subchannel_packs(
+		const std::vector<pointer<array<SUBCHANNELS_LENGTH, byte_t>>>& subchannels_data,
+		si_t first_sector_index
+	) -> void;
 }
 }
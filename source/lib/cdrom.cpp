@@ -1 +1,355 @@
 #include "cdrom.h"
+
+#include <cstring>
+#include <vector>
+#include "crc.h"
+
+namespace overdrive {
+namespace cdrom {
+	// This is the truncated version of P(X) = X^8 + X^4 + X^3 + X^2 + 1.
+	const auto TRUNCATED_8BIT_POLYNOMIAL = ui08_t(0x1D);
+	const auto P_PARITY_MAJOR_COUNT = size_t(86);
+	const auto P_PARITY_MINOR_COUNT = size_t(24);
+	const auto P_PARITY_MAJOR_MULTIPLIER = size_t(2);
+	const auto P_PARITY_MINOR_INCREMENT = size_t(86);
+	const auto Q_PARITY_MAJOR_COUNT = size_t(52);
+	const auto Q_PARITY_MINOR_COUNT = size_t(43);
+	const auto Q_PARITY_MAJOR_MULTIPLIER = size_t(86);
+	const auto Q_PARITY_MINOR_INCREMENT = size_t(88);
+	const auto GF256_ORDER = size_t(255);
+	const auto MAX_ECC_CORRECTION_ITERATIONS = size_t(8);
+
+	static_assert(P_PARITY_MAJOR_COUNT * P_PARITY_MINOR_COUNT == P_PARITY_DATA_LENGTH);
+	static_assert(Q_PARITY_MAJOR_COUNT * Q_PARITY_MINOR_COUNT == Q_PARITY_DATA_LENGTH);
+
+	namespace internal {
+	namespace {
+		// Maps a to a * x in GF(256).
+		auto ECC_FORWARD_TABLE() -> constant<array<256, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[256];
+			if (!initialized) {
+				for (auto byte_index = size_t(0); byte_index < size_t(256); byte_index += 1) {
+					auto value = ui08_t(byte_index);
+					auto wont_overflow = (value & 0x80) == 0;
+					if (wont_overflow) {
+						table[byte_index] = (value << 1);
+					} else {
+						table[byte_index] = (value << 1) ^ TRUNCATED_8BIT_POLYNOMIAL;
+					}
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		// Maps a * (x + 1) to a in GF(256).
+		auto ECC_BACKWARD_TABLE() -> constant<array<256, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[256];
+			if (!initialized) {
+				auto& forward_table = ECC_FORWARD_TABLE();
+				for (auto byte_index = size_t(0); byte_index < size_t(256); byte_index += 1) {
+					table[byte_index ^ forward_table[byte_index]] = byte_t(byte_index);
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		auto GF256_EXP_TABLE() -> constant<array<GF256_ORDER * 2, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[GF256_ORDER * 2];
+			if (!initialized) {
+				auto& forward_table = ECC_FORWARD_TABLE();
+				auto value = byte_t(1);
+				for (auto exponent = size_t(0); exponent < GF256_ORDER * 2; exponent += 1) {
+					table[exponent] = value;
+					value = forward_table[value];
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		auto GF256_LOG_TABLE() -> constant<array<GF256_ORDER + 1, byte_t>>& {
+			static auto initialized = false;
+			static byte_t table[GF256_ORDER + 1];
+			if (!initialized) {
+				auto& exp_table = GF256_EXP_TABLE();
+				table[0] = 0;
+				for (auto exponent = size_t(0); exponent < GF256_ORDER; exponent += 1) {
+					table[exp_table[exponent]] = byte_t(exponent);
+				}
+				initialized = true;
+			}
+			return table;
+		}
+
+		auto gf256_divide(
+			byte_t a,
+			byte_t b
+		) -> byte_t {
+			if (a == 0) {
+				return 0;
+			}
+			return GF256_EXP_TABLE()[GF256_LOG_TABLE()[a] + GF256_ORDER - GF256_LOG_TABLE()[b]];
+		}
+
+		auto gf256_multiply(
+			byte_t a,
+			byte_t b
+		) -> byte_t {
+			if (a == 0 || b == 0) {
+				return 0;
+			}
+			return GF256_EXP_TABLE()[GF256_LOG_TABLE()[a] + GF256_LOG_TABLE()[b]];
+		}
+
+		auto gf256_power(
+			size_t exponent
+		) -> byte_t {
+			return GF256_EXP_TABLE()[exponent % GF256_ORDER];
+		}
+
+		// Computes two parity bytes for each of the major_count code words of minor_count bytes.
+		auto compute_ecc_block(
+			const byte_t* data,
+			size_t major_count,
+			size_t minor_count,
+			size_t major_multiplier,
+			size_t minor_increment,
+			byte_t* parity
+		) -> void {
+			auto& forward_table = ECC_FORWARD_TABLE();
+			auto& backward_table = ECC_BACKWARD_TABLE();
+			auto size = major_count * minor_count;
+			for (auto major_index = size_t(0); major_index < major_count; major_index += 1) {
+				auto index = (major_index >> 1) * major_multiplier + (major_index & 1);
+				auto ecc_a = byte_t(0);
+				auto ecc_b = byte_t(0);
+				for (auto minor_index = size_t(0); minor_index < minor_count; minor_index += 1) {
+					auto byte = data[index];
+					index += minor_increment;
+					if (index >= size) {
+						index -= size;
+					}
+					ecc_a ^= byte;
+					ecc_b ^= byte;
+					ecc_a = forward_table[ecc_a];
+				}
+				ecc_a = backward_table[forward_table[ecc_a] ^ ecc_b];
+				parity[major_index] = ecc_a;
+				parity[major_index + major_count] = ecc_a ^ ecc_b;
+			}
+		}
+
+		auto is_erased(
+			const byte_t* c2_data,
+			size_t index
+		) -> bool_t {
+			if (c2_data == nullptr) {
+				return false;
+			}
+			auto sector_index = SYNC_LENGTH + index;
+			return (c2_data[sector_index >> 3] & (0x80 >> (sector_index & 7))) != 0;
+		}
+
+		// Corrects one error or two erasures in a code word whose syndromes are computed with weights a^(length - 1) through a^0.
+		auto correct_ecc_code_word(
+			byte_t* data,
+			const size_t* indices,
+			size_t length,
+			std::vector<bool_t>& erasures
+		) -> bool_t {
+			auto& forward_table = ECC_FORWARD_TABLE();
+			auto syndrome_0 = byte_t(0);
+			auto syndrome_1 = byte_t(0);
+			size_t erased_positions[2];
+			auto erasure_count = size_t(0);
+			for (auto position = size_t(0); position < length; position += 1) {
+				auto byte = data[indices[position]];
+				syndrome_0 ^= byte;
+				syndrome_1 = forward_table[syndrome_1] ^ byte;
+				if (erasures.at(indices[position])) {
+					if (erasure_count < 2) {
+						erased_positions[erasure_count] = position;
+					}
+					erasure_count += 1;
+				}
+			}
+			if (syndrome_0 == 0 && syndrome_1 == 0) {
+				for (auto position = size_t(0); position < length; position += 1) {
+					erasures.at(indices[position]) = false;
+				}
+				return false;
+			}
+			if (erasure_count == 2) {
+				auto locator_0 = gf256_power(length - 1 - erased_positions[0]);
+				auto locator_1 = gf256_power(length - 1 - erased_positions[1]);
+				auto magnitude_0 = gf256_divide(syndrome_1 ^ gf256_multiply(syndrome_0, locator_1), locator_0 ^ locator_1);
+				auto magnitude_1 = byte_t(syndrome_0 ^ magnitude_0);
+				data[indices[erased_positions[0]]] ^= magnitude_0;
+				data[indices[erased_positions[1]]] ^= magnitude_1;
+			} else if (erasure_count <= 1) {
+				if (syndrome_0 == 0 || syndrome_1 == 0) {
+					return false;
+				}
+				auto exponent = size_t(GF256_LOG_TABLE()[gf256_divide(syndrome_1, syndrome_0)]);
+				if (exponent >= length) {
+					return false;
+				}
+				auto position = length - 1 - exponent;
+				if (erasure_count == 1 && position != erased_positions[0]) {
+					return false;
+				}
+				data[indices[position]] ^= syndrome_0;
+			} else {
+				return false;
+			}
+			for (auto position = size_t(0); position < length; position += 1) {
+				erasures.at(indices[position]) = false;
+			}
+			return true;
+		}
+	}
+	}
+
+	auto compute_ecc(
+		const byte_t* sector_data,
+		bool_t zero_header,
+		array<P_PARITY_LENGTH, byte_t>& p_parity,
+		array<Q_PARITY_LENGTH, byte_t>& q_parity
+	) -> void {
+		byte_t data[Q_PARITY_DATA_LENGTH];
+		std::memcpy(data, sector_data + SYNC_LENGTH, P_PARITY_DATA_LENGTH);
+		if (zero_header) {
+			std::memset(data, 0, HEADER_LENGTH);
+		}
+		internal::compute_ecc_block(data, P_PARITY_MAJOR_COUNT, P_PARITY_MINOR_COUNT, P_PARITY_MAJOR_MULTIPLIER, P_PARITY_MINOR_INCREMENT, p_parity);
+		std::memcpy(data + P_PARITY_DATA_LENGTH, p_parity, P_PARITY_LENGTH);
+		internal::compute_ecc_block(data, Q_PARITY_MAJOR_COUNT, Q_PARITY_MINOR_COUNT, Q_PARITY_MAJOR_MULTIPLIER, Q_PARITY_MINOR_INCREMENT, q_parity);
+	}
+
+	auto is_valid_ecc(
+		const byte_t* sector_data,
+		bool_t zero_header
+	) -> bool_t {
+		byte_t p_parity[P_PARITY_LENGTH];
+		byte_t q_parity[Q_PARITY_LENGTH];
+		compute_ecc(sector_data, zero_header, p_parity, q_parity);
+		if (std::memcmp(p_parity, sector_data + SYNC_LENGTH + P_PARITY_DATA_LENGTH, P_PARITY_LENGTH) != 0) {
+			return false;
+		}
+		if (std::memcmp(q_parity, sector_data + SYNC_LENGTH + Q_PARITY_DATA_LENGTH, Q_PARITY_LENGTH) != 0) {
+			return false;
+		}
+		return true;
+	}
+
+	auto correct_ecc(
+		byte_t* sector_data,
+		bool_t zero_header,
+		const byte_t* c2_data
+	) -> bool_t {
+		byte_t data[Q_PARITY_DATA_LENGTH + Q_PARITY_LENGTH];
+		std::memcpy(data, sector_data + SYNC_LENGTH, sizeof(data));
+		if (zero_header) {
+			std::memset(data, 0, HEADER_LENGTH);
+		}
+		auto erasures = std::vector<bool_t>(sizeof(data));
+		for (auto index = size_t(0); index < sizeof(data); index += 1) {
+			erasures.at(index) = internal::is_erased(c2_data, index);
+		}
+		size_t p_indices[P_PARITY_MINOR_COUNT + 2];
+		size_t q_indices[Q_PARITY_MINOR_COUNT + 2];
+		// The P and Q code words intersect so corrections made by one may enable corrections by the other.
+		for (auto iteration = size_t(0); iteration < MAX_ECC_CORRECTION_ITERATIONS; iteration += 1) {
+			auto corrected = false;
+			for (auto major_index = size_t(0); major_index < P_PARITY_MAJOR_COUNT; major_index += 1) {
+				auto index = (major_index >> 1) * P_PARITY_MAJOR_MULTIPLIER + (major_index & 1);
+				for (auto minor_index = size_t(0); minor_index < P_PARITY_MINOR_COUNT; minor_index += 1) {
+					p_indices[minor_index] = index;
+					index = (index + P_PARITY_MINOR_INCREMENT) % P_PARITY_DATA_LENGTH;
+				}
+				p_indices[P_PARITY_MINOR_COUNT + 0] = P_PARITY_DATA_LENGTH + major_index;
+				p_indices[P_PARITY_MINOR_COUNT + 1] = P_PARITY_DATA_LENGTH + P_PARITY_MAJOR_COUNT + major_index;
+				corrected = internal::correct_ecc_code_word(data, p_indices, P_PARITY_MINOR_COUNT + 2, erasures) || corrected;
+			}
+			for (auto major_index = size_t(0); major_index < Q_PARITY_MAJOR_COUNT; major_index += 1) {
+				auto index = (major_index >> 1) * Q_PARITY_MAJOR_MULTIPLIER + (major_index & 1);
+				for (auto minor_index = size_t(0); minor_index < Q_PARITY_MINOR_COUNT; minor_index += 1) {
+					q_indices[minor_index] = index;
+					index = (index + Q_PARITY_MINOR_INCREMENT) % Q_PARITY_DATA_LENGTH;
+				}
+				q_indices[Q_PARITY_MINOR_COUNT + 0] = Q_PARITY_DATA_LENGTH + major_index;
+				q_indices[Q_PARITY_MINOR_COUNT + 1] = Q_PARITY_DATA_LENGTH + Q_PARITY_MAJOR_COUNT + major_index;
+				corrected = internal::correct_ecc_code_word(data, q_indices, Q_PARITY_MINOR_COUNT + 2, erasures) || corrected;
+			}
+			if (!corrected) {
+				break;
+			}
+		}
+		if (zero_header) {
+			std::memcpy(data, sector_data + SYNC_LENGTH, HEADER_LENGTH);
+		}
+		std::memcpy(sector_data + SYNC_LENGTH, data, sizeof(data));
+		return is_valid_ecc(sector_data, zero_header);
+	}
+
+	auto encode_edc(
+		ui32_t edc,
+		array<EDC_LENGTH, byte_t>& edc_data
+	) -> void {
+		edc_data[0] = (edc >> 0) & 0xFF;
+		edc_data[1] = (edc >> 8) & 0xFF;
+		edc_data[2] = (edc >> 16) & 0xFF;
+		edc_data[3] = (edc >> 24) & 0xFF;
+	}
+
+	auto decode_edc(
+		const array<EDC_LENGTH, byte_t>& edc_data
+	) -> ui32_t {
+		auto edc = ui32_t(0);
+		edc |= ui32_t(edc_data[0]) << 0;
+		edc |= ui32_t(edc_data[1]) << 8;
+		edc |= ui32_t(edc_data[2]) << 16;
+		edc |= ui32_t(edc_data[3]) << 24;
+		return edc;
+	}
+
+	auto encode_mode1_sector(
+		Mode1Sector& sector
+	) -> void {
+		auto sector_data = reinterpret_cast<byte_t*>(&sector);
+		encode_edc(crc::compute_edc(sector_data, MODE1_EDC_DATA_LENGTH), sector.edc);
+		std::memset(sector.pad, 0, sizeof(sector.pad));
+		compute_ecc(sector_data, false, *reinterpret_cast<array<P_PARITY_LENGTH, byte_t>*>(sector.ecc), *reinterpret_cast<array<Q_PARITY_LENGTH, byte_t>*>(sector.ecc + P_PARITY_LENGTH));
+	}
+
+	auto is_valid_mode1_sector(
+		const Mode1Sector& sector
+	) -> bool_t {
+		auto sector_data = reinterpret_cast<const byte_t*>(&sector);
+		if (crc::compute_edc(sector_data, MODE1_EDC_DATA_LENGTH) != decode_edc(sector.edc)) {
+			return false;
+		}
+		return is_valid_ecc(sector_data, false);
+	}
+	auto correct_mode1_sector(
+		Mode1Sector& sector,
+		const byte_t* c2_data
+	) -> bool_t {
+		auto corrected_sector = sector;
+		auto sector_data = reinterpret_cast<byte_t*>(&corrected_sector);
+		if (!correct_ecc(sector_data, false, c2_data)) {
+			return false;
+		}
+		if (!is_valid_mode1_sector(corrected_sector)) {
+			return false;
+		}
+		sector = corrected_sector;
+		return true;
+	}
+}
+}
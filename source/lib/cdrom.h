@@ -23,6 +23,9 @@ namespace cdrom {
 	const auto MODE1_DATA_LENGTH = size_t(BASE_SECTOR_DATA_LENGTH - EDC_PAD_ECC_LENGTH);
 	const auto MODE2_SECTOR_LENGTH = size_t(BASE_SECTOR_LENGTH);
 	const auto MODE2_DATA_LENGTH = size_t(BASE_SECTOR_DATA_LENGTH);
+	const auto MODE1_EDC_DATA_LENGTH = size_t(SYNC_HEADER_LENGTH + MODE1_DATA_LENGTH);
+	const auto P_PARITY_DATA_LENGTH = size_t(HEADER_LENGTH + MODE1_DATA_LENGTH + EDC_LENGTH + PAD_LENGTH);
+	const auto Q_PARITY_DATA_LENGTH = size_t(P_PARITY_DATA_LENGTH + P_PARITY_LENGTH);
 
 	#pragma pack(push, 1)
 
@@ -67,5 +70,47 @@ namespace cdrom {
 	static_assert(sizeof(Sector) == SECTOR_LENGTH);
 
 	#pragma pack(pop)
+
+	auto compute_ecc(
+		const byte_t* sector_data,
+		bool_t zero_header,
+		array<P_PARITY_LENGTH, byte_t>& p_parity,
+		array<Q_PARITY_LENGTH, byte_t>& q_parity
+	) -> void;
+
+	auto is_valid_ecc(
+		const byte_t* sector_data,
+		bool_t zero_header
+	) -> bool_t;
+
+	// Corrects errors using the P and Q parity. Bytes flagged in the C2 data are treated as erasures.
+	auto correct_ecc(
+		byte_t* sector_data,
+		bool_t zero_header,
+		const byte_t* c2_data
+	) -> bool_t;
+
+	auto encode_edc(
+		ui32_t edc,
+		array<EDC_LENGTH, byte_t>& edc_data
+	) -> void;
+
+	auto decode_edc(
+		const array<EDC_LENGTH, byte_t>& edc_data
+	) -> ui32_t;
+
+	auto encode_mode1_sector(
+		Mode1Sector& sector
+	) -> void;
+
+	auto is_valid_mode1_sector(
+		const Mode1Sector& sector
+	) -> bool_t;
+
+	// The sector is left unmodified unless it can be corrected into a sector with valid EDC and ECC.
+	auto correct_mode1_sector(
+		Mode1Sector& sector,
+		const byte_t* c2_data
+	) -> bool_t;
 }
 }
@@ -1 +1,59 @@
 #include "cdxa.h"
+
+#include "crc.h"
+
+namespace overdrive {
+namespace cdxa {
+	auto encode_mode2_form1_sector(
+		Mode2Form1Sector& sector
+	) -> void {
+		auto sector_data = reinterpret_cast<byte_t*>(&sector);
+		cdrom::encode_edc(crc::compute_edc(sector_data + cdrom::SYNC_HEADER_LENGTH, MODE2_FORM1_EDC_DATA_LENGTH), sector.edc);
+		cdrom::compute_ecc(sector_data, true, sector.p_parity, sector.q_parity);
+	}
+
+	auto is_valid_mode2_form1_sector(
+		const Mode2Form1Sector& sector
+	) -> bool_t {
+		auto sector_data = reinterpret_cast<const byte_t*>(&sector);
+		if (crc::compute_edc(sector_data + cdrom::SYNC_HEADER_LENGTH, MODE2_FORM1_EDC_DATA_LENGTH) != cdrom::decode_edc(sector.edc)) {
+			return false;
+		}
+		return cdrom::is_valid_ecc(sector_data, true);
+	}
+
+	auto correct_mode2_form1_sector(
+		Mode2Form1Sector& sector,
+		const byte_t* c2_data
+	) -> bool_t {
+		auto corrected_sector = sector;
+		auto sector_data = reinterpret_cast<byte_t*>(&corrected_sector);
+		if (!cdrom::correct_ecc(sector_data, true, c2_data)) {
+			return false;
+		}
+		if (!is_valid_mode2_form1_sector(corrected_sector)) {
+			return false;
+		}
+		sector = corrected_sector;
+		return true;
+	}
+
+	auto encode_mode2_form2_sector(
+		Mode2Form2Sector& sector
+	) -> void {
+		auto sector_data = reinterpret_cast<byte_t*>(&sector);
+		cdrom::encode_edc(crc::compute_edc(sector_data + cdrom::SYNC_HEADER_LENGTH, MODE2_FORM2_EDC_DATA_LENGTH), sector.optional_edc);
+	}
+
+	auto is_valid_mode2_form2_sector(
+		const Mode2Form2Sector& sector
+	) -> bool_t {
+		auto sector_data = reinterpret_cast<const byte_t*>(&sector);
+		auto edc = cdrom::decode_edc(sector.optional_edc);
+		if (edc == 0) {
+			return false;
+		}
+		return crc::compute_edc(sector_data + cdrom::SYNC_HEADER_LENGTH, MODE2_FORM2_EDC_DATA_LENGTH) == edc;
+	}
+}
+}
@@ -16,6 +16,8 @@ namespace cdxa {
 	const auto MODE2_FORM1_DATA_LENGTH = size_t(BASE_SECTOR_DATA_LENGTH - cdrom::EDC_LENGTH - cdrom::ECC_LENGTH);
 	const auto MODE2_FORM2_SECTOR_LENGTH = size_t(BASE_SECTOR_LENGTH);
 	const auto MODE2_FORM2_DATA_LENGTH = size_t(BASE_SECTOR_DATA_LENGTH - cdrom::EDC_LENGTH);
+	const auto MODE2_FORM1_EDC_DATA_LENGTH = size_t(SUBHEADER_LENGTH + SUBHEADER_LENGTH + MODE2_FORM1_DATA_LENGTH);
+	const auto MODE2_FORM2_EDC_DATA_LENGTH = size_t(SUBHEADER_LENGTH + SUBHEADER_LENGTH + MODE2_FORM2_DATA_LENGTH);
 
 	#pragma pack(push, 1)
 
@@ -75,5 +77,28 @@ namespace cdxa {
 	static_assert(sizeof(Sector) == SECTOR_LENGTH);
 
 	#pragma pack(pop)
+
+	auto encode_mode2_form1_sector(
+		Mode2Form1Sector& sector
+	) -> void;
+
+	auto is_valid_mode2_form1_sector(
+		const Mode2Form1Sector& sector
+	) -> bool_t;
+
+	// The sector is left unmodified unless it can be corrected into a sector with valid EDC and ECC.
+	auto correct_mode2_form1_sector(
+		Mode2Form1Sector& sector,
+		const byte_t* c2_data
+	) -> bool_t;
+
+	auto encode_mode2_form2_sector(
+		Mode2Form2Sector& sector
+	) -> void;
+
+	// The EDC is optional for Form 2 sectors which means that sectors without EDC cannot be validated.
+	auto is_valid_mode2_form2_sector(
+		const Mode2Form2Sector& sector
+	) -> bool_t;
 }
 }
@@ -4,6 +4,9 @@ namespace overdrive {
 namespace crc {
 	// This is the truncated version of P(X) = X^16 + X^12 + X^5 + 1.
 	const auto TRUNCATED_16BIT_POLYNOMIAL = ui16_t(0x1021);
+	// This is the reversed version of P(X) = (X^16 + X^15 + X^2 + 1) * (X^16 + X^2 + X + 1).
+	const auto REVERSED_32BIT_EDC_POLYNOMIAL = ui32_t(0xD8018001);
+	const auto EDC_SLICE_COUNT = size_t(4);
 
 	namespace internal {
 	namespace {
@@ -27,6 +30,34 @@ namespace crc {
 			}
 			return table;
 		}
+
+		// The tables are used for processing four bytes per step (slicing-by-4).
+		auto EDC_TABLES() -> constant<array<EDC_SLICE_COUNT, array<256, ui32_t>>>& {
+			static auto initialized = false;
+			static ui32_t tables[EDC_SLICE_COUNT][256];
+			if (!initialized) {
+				for (auto byte_index = size_t(0); byte_index < size_t(256); byte_index += 1) {
+					auto value = ui32_t(byte_index);
+					for (auto bit_index = size_t(0); bit_index < size_t(8); bit_index += 1) {
+						auto wont_overflow = (value & 1) == 0;
+						if (wont_overflow) {
+							value = (value >> 1);
+						} else {
+							value = (value >> 1) ^ REVERSED_32BIT_EDC_POLYNOMIAL;
+						}
+					}
+					tables[0][byte_index] = value;
+				}
+				for (auto slice_index = size_t(1); slice_index < EDC_SLICE_COUNT; slice_index += 1) {
+					for (auto byte_index = size_t(0); byte_index < size_t(256); byte_index += 1) {
+						auto value = tables[slice_index - 1][byte_index];
+						tables[slice_index][byte_index] = (value >> 8) ^ tables[0][value & 0xFF];
+					}
+				}
+				initialized = true;
+			}
+			return tables;
+		}
 	}
 	}
 
@@ -42,5 +73,40 @@ namespace crc {
 		}
 		return ~crc;
 	}
+
+	auto compute_edc(
+		const byte_t* buffer,
+		size_t size
+	) -> ui32_t {
+		auto edc = ui32_t(0);
+		auto& tables = internal::EDC_TABLES();
+		auto byte_index = size_t(0);
+		while (byte_index + EDC_SLICE_COUNT <= size) {
+			edc ^= ui32_t(buffer[byte_index + 0]) << 0;
+			edc ^= ui32_t(buffer[byte_index + 1]) << 8;
+			edc ^= ui32_t(buffer[byte_index + 2]) << 16;
+			edc ^= ui32_t(buffer[byte_index + 3]) << 24;
+			edc = tables[3][(edc >> 0) & 0xFF] ^ tables[2][(edc >> 8) & 0xFF] ^ tables[1][(edc >> 16) & 0xFF] ^ tables[0][(edc >> 24) & 0xFF];
+			byte_index += EDC_SLICE_COUNT;
+		}
+		while (byte_index < size) {
+			edc = (edc >> 8) ^ tables[0][(edc ^ buffer[byte_index]) & 0xFF];
+			byte_index += 1;
+		}
+		return edc;
+	}
+
+	auto compute_crc16_bit_error_syndrome(
+		size_t size,
+		size_t bit_index
+	) -> ui16_t {
+		auto crc = ui16_t(0);
+		auto& table = internal::CRC16_TABLE();
+		for (auto byte_index = bit_index >> 3; byte_index < size; byte_index += 1) {
+			auto byte = byte_index == (bit_index >> 3) ? byte_t(0x80 >> (bit_index & 7)) : byte_t(0x00);
+			crc = (crc << 8) ^ table[((crc >> 8) & 0xFF) ^ byte];
+		}
+		return crc;
+	}
 }
 }
@@ -10,5 +10,16 @@ namespace crc {
 		const byte_t* buffer,
 		size_t size
 	) -> ui16_t;
+
+	auto compute_edc(
+		const byte_t* buffer,
+		size_t size
+	) -> ui32_t;
+
+	// Computes the value that the CRC-16 of a buffer of the given size changes by when the given bit is flipped.
+	auto compute_crc16_bit_error_syndrome(
+		size_t size,
+		size_t bit_index
+	) -> ui16_t;
 }
 }
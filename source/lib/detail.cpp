@@ -1,12 +1,255 @@
 #include "detail.h"
 
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <exception>
 #include <format>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <regex>
+#include <thread>
 #include <vector>
 #include "exceptions.h"
 #include "string.h"
 
+namespace overdrive {
+namespace detail {
+	namespace internal {
+	namespace {
+		class SynchronousState {
+			public:
+
+			size_t next_request_id;
+			std::map<size_t, scsi::StatusCode::type> status_codes;
+
+			protected:
+		};
+
+		class QueuedRequest {
+			public:
+
+			void* handle;
+			std::vector<byte_t> cdb;
+			byte_t* data;
+			size_t data_size;
+			pointer<array<255, byte_t>> sense;
+			bool_t write_to_device;
+			bool_t completed;
+			scsi::StatusCode::type status;
+			std::exception_ptr exception;
+
+			protected:
+		};
+
+		class QueuedState {
+			public:
+
+			QueuedState(
+				const ioctl_t& ioctl,
+				size_t queue_depth
+			);
+
+			~QueuedState(
+			);
+
+			auto submit(
+				void* handle,
+				byte_t* cdb,
+				size_t cdb_size,
+				byte_t* data,
+				size_t data_size,
+				pointer<array<255, byte_t>> sense,
+				bool_t write_to_device
+			) -> size_t;
+
+			auto complete(
+				void* handle,
+				size_t request_id
+			) -> scsi::StatusCode::type;
+
+			protected:
+
+			auto run(
+			) -> void;
+
+			ioctl_t ioctl;
+			size_t queue_depth;
+			std::mutex mutex;
+			std::condition_variable condition;
+			std::deque<size_t> pending_request_ids;
+			std::map<size_t, QueuedRequest> requests;
+			size_t next_request_id;
+			size_t outstanding_request_count;
+			bool_t stopped;
+			std::thread thread;
+		};
+
+		QueuedState::QueuedState(
+			const ioctl_t& ioctl,
+			size_t queue_depth
+		) {
+			this->ioctl = ioctl;
+			this->queue_depth = std::max<size_t>(1, queue_depth);
+			this->next_request_id = 0;
+			this->outstanding_request_count = 0;
+			this->stopped = false;
+			this->thread = std::thread([this]() -> void {
+				this->run();
+			});
+		}
+
+		QueuedState::~QueuedState(
+		) {
+			{
+				auto lock = std::unique_lock<std::mutex>(this->mutex);
+				this->stopped = true;
+			}
+			this->condition.notify_all();
+			this->thread.join();
+		}
+
+		auto QueuedState::submit(
+			void* handle,
+			byte_t* cdb,
+			size_t cdb_size,
+			byte_t* data,
+			size_t data_size,
+			pointer<array<255, byte_t>> sense,
+			bool_t write_to_device
+		) -> size_t {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->condition.wait(lock, [&]() -> bool_t {
+				return this->outstanding_request_count < this->queue_depth;
+			});
+			auto request_id = this->next_request_id;
+			this->next_request_id += 1;
+			auto& request = this->requests[request_id];
+			request.handle = handle;
+			request.cdb = std::vector<byte_t>(cdb, cdb + cdb_size);
+			request.data = data;
+			request.data_size = data_size;
+			request.sense = sense;
+			request.write_to_device = write_to_device;
+			request.completed = false;
+			this->pending_request_ids.push_back(request_id);
+			this->outstanding_request_count += 1;
+			this->condition.notify_all();
+			return request_id;
+		}
+
+		auto QueuedState::complete(
+			void* handle,
+			size_t request_id
+		) -> scsi::StatusCode::type {
+			(void)handle;
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			auto iterator = this->requests.find(request_id);
+			if (iterator == this->requests.end()) {
+				OVERDRIVE_THROW(exceptions::MissingValueException("request"));
+			}
+			auto& request = iterator->second;
+			this->condition.wait(lock, [&]() -> bool_t {
+				return request.completed;
+			});
+			auto status = request.status;
+			auto exception = request.exception;
+			this->requests.erase(iterator);
+			if (exception) {
+				std::rethrow_exception(exception);
+			}
+			return status;
+		}
+
+		auto QueuedState::run(
+		) -> void {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			while (true) {
+				this->condition.wait(lock, [&]() -> bool_t {
+					return this->stopped || !this->pending_request_ids.empty();
+				});
+				if (this->stopped) {
+					return;
+				}
+				auto request_id = this->pending_request_ids.front();
+				this->pending_request_ids.pop_front();
+				auto& request = this->requests.at(request_id);
+				lock.unlock();
+				auto status = scsi::StatusCode::CHECK_CONDITION;
+				auto exception = std::exception_ptr();
+				try {
+					status = this->ioctl(request.handle, request.cdb.data(), request.cdb.size(), request.data, request.data_size, request.sense, request.write_to_device);
+				} catch (...) {
+					exception = std::current_exception();
+				}
+				lock.lock();
+				request.status = status;
+				request.exception = exception;
+				request.completed = true;
+				this->outstanding_request_count -= 1;
+				this->condition.notify_all();
+			}
+		}
+	}
+	}
+
+	auto create_synchronous_detail(
+		const get_handle_t& get_handle,
+		const ioctl_t& ioctl
+	) -> Detail {
+		auto state = std::make_shared<internal::SynchronousState>();
+		auto submit = [=](void* handle, byte_t* cdb, size_t cdb_size, byte_t* data, size_t data_size, pointer<array<255, byte_t>> sense, bool_t write_to_device) -> size_t {
+			auto request_id = state->next_request_id;
+			state->next_request_id += 1;
+			state->status_codes[request_id] = ioctl(handle, cdb, cdb_size, data, data_size, sense, write_to_device);
+			return request_id;
+		};
+		auto complete = [=](void* handle, size_t request_id) -> scsi::StatusCode::type {
+			(void)handle;
+			auto iterator = state->status_codes.find(request_id);
+			if (iterator == state->status_codes.end()) {
+				OVERDRIVE_THROW(exceptions::MissingValueException("request"));
+			}
+			auto status = iterator->second;
+			state->status_codes.erase(iterator);
+			return status;
+		};
+		return {
+			get_handle,
+			ioctl,
+			submit,
+			complete,
+			1
+		};
+	}
+
+	auto create_queued_detail(
+		const Detail& detail,
+		size_t queue_depth
+	) -> Detail {
+		auto state = std::make_shared<internal::QueuedState>(detail.ioctl, queue_depth);
+		auto ioctl = [=](void* handle, byte_t* cdb, size_t cdb_size, byte_t* data, size_t data_size, pointer<array<255, byte_t>> sense, bool_t write_to_device) -> scsi::StatusCode::type {
+			auto request_id = state->submit(handle, cdb, cdb_size, data, data_size, sense, write_to_device);
+			return state->complete(handle, request_id);
+		};
+		auto submit = [=](void* handle, byte_t* cdb, size_t cdb_size, byte_t* data, size_t data_size, pointer<array<255, byte_t>> sense, bool_t write_to_device) -> size_t {
+			return state->submit(handle, cdb, cdb_size, data, data_size, sense, write_to_device);
+		};
+		auto complete = [=](void* handle, size_t request_id) -> scsi::StatusCode::type {
+			return state->complete(handle, request_id);
+		};
+		return {
+			detail.get_handle,
+			ioctl,
+			submit,
+			complete,
+			queue_depth
+		};
+	}
+}
+}
+
 #if _WIN32 || _WIN64
 
 #include <errhandlingapi.h>
@@ -88,9 +331,237 @@ namespace detail {
 	) -> Detail {
 		auto get_handle = internal::get_handle;
 		auto ioctl = internal::ioctl;
+		return create_synchronous_detail(get_handle, ioctl);
+	}
+}
+}
+
+#elif __linux__
+
+#include <cerrno>
+#include <fcntl.h>
+#include <scsi/sg.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+namespace overdrive {
+namespace detail {
+	namespace internal {
+	namespace {
+		const auto SCSI_GENERIC_MAJOR = ui_t(21);
+		const auto DRIVER_SENSE = ui_t(0x08);
+		const auto TIMEOUT_MS = ui_t(10000);
+
+		class Request {
+			public:
+
+			sg_io_hdr_t header;
+			byte_t sense[255];
+			pointer<array<255, byte_t>> target_sense;
+
+			protected:
+		};
+
+		class Device {
+			public:
+
+			Device(
+				si_t file_descriptor
+			);
+
+			Device(
+				const Device& other
+			) = delete;
+
+			~Device(
+			);
+
+			auto operator =(
+				const Device& other
+			) -> Device& = delete;
+
+			si_t file_descriptor;
+			// Only the SCSI generic driver supports asynchronous submission through write() and read().
+			bool_t supports_queueing;
+			size_t next_request_id;
+			std::map<size_t, Request> requests;
+
+			protected:
+		};
+
+		Device::Device(
+			si_t file_descriptor
+		) {
+			this->file_descriptor = file_descriptor;
+			this->supports_queueing = false;
+			this->next_request_id = 0;
+		}
+
+		Device::~Device(
+		) {
+			::close(this->file_descriptor);
+		}
+
+		// The handles are owned by the process and closed when it exits.
+		auto get_devices(
+		) -> std::vector<std::unique_ptr<Device>>& {
+			static auto devices = std::vector<std::unique_ptr<Device>>();
+			return devices;
+		}
+
+		auto create_header(
+			byte_t* cdb,
+			size_t cdb_size,
+			byte_t* data,
+			size_t data_size,
+			byte_t* sense,
+			bool_t write_to_device
+		) -> sg_io_hdr_t {
+			auto header = sg_io_hdr_t();
+			header.interface_id = 'S';
+			header.dxfer_direction = data_size == 0 ? SG_DXFER_NONE : write_to_device ? SG_DXFER_TO_DEV : SG_DXFER_FROM_DEV;
+			header.cmd_len = cdb_size;
+			header.mx_sb_len = 255;
+			header.dxfer_len = data_size;
+			header.dxferp = data;
+			header.cmdp = cdb;
+			header.sbp = sense;
+			header.timeout = TIMEOUT_MS;
+			return header;
+		}
+
+		auto get_status(
+			const sg_io_hdr_t& header
+		) -> scsi::StatusCode::type {
+			if (header.host_status != 0 || (header.driver_status & ~DRIVER_SENSE) != 0) {
+				return header.status != scsi::StatusCode::GOOD ? header.status : scsi::StatusCode::CHECK_CONDITION;
+			}
+			return header.status;
+		}
+
+		auto get_handle(
+			const std::string& drive
+		) -> void* {
+			auto matches = std::vector<std::string>();
+			if (!string::match(drive, matches, std::regex("^(/dev/.+)$"))) {
+				OVERDRIVE_THROW(exceptions::BadArgumentFormatException(drive, "path"));
+			}
+			auto file_descriptor = ::open(matches.at(0).c_str(), O_RDWR | O_NONBLOCK);
+			if (file_descriptor < 0) {
+				OVERDRIVE_THROW(exceptions::LinuxException(errno));
+			}
+			// The device closes the descriptor should any of the following steps fail.
+			auto device = std::make_unique<Device>(file_descriptor);
+			// The device is opened in non-blocking mode in order not to wait for the tray but reads must block until commands complete.
+			auto flags = ::fcntl(file_descriptor, F_GETFL);
+			if (flags < 0 || ::fcntl(file_descriptor, F_SETFL, flags & ~O_NONBLOCK) < 0) {
+				OVERDRIVE_THROW(exceptions::LinuxException(errno));
+			}
+			struct stat file_status = {};
+			if (::fstat(file_descriptor, &file_status) < 0) {
+				OVERDRIVE_THROW(exceptions::LinuxException(errno));
+			}
+			device->supports_queueing = S_ISCHR(file_status.st_mode) && major(file_status.st_rdev) == SCSI_GENERIC_MAJOR;
+			if (device->supports_queueing) {
+				auto force_pack_id = si_t(1);
+				if (::ioctl(file_descriptor, SG_SET_FORCE_PACK_ID, &force_pack_id) < 0) {
+					OVERDRIVE_THROW(exceptions::LinuxException(errno));
+				}
+			}
+			auto& devices = get_devices();
+			devices.push_back(std::move(device));
+			return devices.back().get();
+		}
+
+		auto ioctl(
+			void* handle,
+			byte_t* cdb,
+			size_t cdb_size,
+			byte_t* data,
+			size_t data_size,
+			pointer<array<255, byte_t>> sense,
+			bool_t write_to_device
+		) -> scsi::StatusCode::type {
+			auto& device = *reinterpret_cast<Device*>(handle);
+			byte_t sense_buffer[255] = {};
+			auto header = create_header(cdb, cdb_size, data, data_size, sense_buffer, write_to_device);
+			if (::ioctl(device.file_descriptor, SG_IO, &header) < 0) {
+				OVERDRIVE_THROW(exceptions::LinuxException(errno));
+			}
+			if (sense != nullptr) {
+				std::memcpy(*sense, sense_buffer, sizeof(*sense));
+			}
+			return get_status(header);
+		}
+
+		auto submit(
+			void* handle,
+			byte_t* cdb,
+			size_t cdb_size,
+			byte_t* data,
+			size_t data_size,
+			pointer<array<255, byte_t>> sense,
+			bool_t write_to_device
+		) -> size_t {
+			auto& device = *reinterpret_cast<Device*>(handle);
+			auto request_id = device.next_request_id;
+			device.next_request_id += 1;
+			auto& request = device.requests[request_id];
+			std::memset(request.sense, 0, sizeof(request.sense));
+			request.target_sense = sense;
+			request.header = create_header(cdb, cdb_size, data, data_size, request.sense, write_to_device);
+			request.header.pack_id = si_t(request_id);
+			// The command is copied by the driver upon submission while the data and sense buffers are used until completion.
+			auto result = device.supports_queueing ? ::write(device.file_descriptor, &request.header, sizeof(request.header)) : ::ioctl(device.file_descriptor, SG_IO, &request.header);
+			if (result < 0) {
+				auto code = errno;
+				device.requests.erase(request_id);
+				OVERDRIVE_THROW(exceptions::LinuxException(code));
+			}
+			return request_id;
+		}
+
+		auto complete(
+			void* handle,
+			size_t request_id
+		) -> scsi::StatusCode::type {
+			auto& device = *reinterpret_cast<Device*>(handle);
+			auto iterator = device.requests.find(request_id);
+			if (iterator == device.requests.end()) {
+				OVERDRIVE_THROW(exceptions::MissingValueException("request"));
+			}
+			auto& request = iterator->second;
+			if (device.supports_queueing) {
+				if (::read(device.file_descriptor, &request.header, sizeof(request.header)) < 0) {
+					auto code = errno;
+					device.requests.erase(iterator);
+					OVERDRIVE_THROW(exceptions::LinuxException(code));
+				}
+			}
+			if (request.target_sense != nullptr) {
+				std::memcpy(*request.target_sense, request.sense, sizeof(*request.target_sense));
+			}
+			auto status = get_status(request.header);
+			device.requests.erase(iterator);
+			return status;
+		}
+	}
+	}
+
+	auto create_detail(
+	) -> Detail {
+		auto get_handle = internal::get_handle;
+		auto ioctl = internal::ioctl;
+		auto submit = internal::submit;
+		auto complete = internal::complete;
 		return {
 			get_handle,
-			ioctl
+			ioctl,
+			submit,
+			complete,
+			MAX_QUEUE_DEPTH
 		};
 	}
 }
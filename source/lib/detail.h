@@ -9,19 +9,37 @@ namespace overdrive {
 namespace detail {
 	using namespace shared;
 
+	const auto MAX_QUEUE_DEPTH = size_t(4);
+
 	using get_handle_t = std::function<void*(const std::string& drive)>;
 	using ioctl_t = std::function<scsi::StatusCode::type(void* handle, byte_t* cdb, size_t cdb_size, byte_t* data, size_t data_size, pointer<array<255, byte_t>> sense, bool_t write_to_device)>;
+	using submit_t = std::function<size_t(void* handle, byte_t* cdb, size_t cdb_size, byte_t* data, size_t data_size, pointer<array<255, byte_t>> sense, bool_t write_to_device)>;
+	using complete_t = std::function<scsi::StatusCode::type(void* handle, size_t request_id)>;
 
 	class Detail {
 		public:
 
 		get_handle_t get_handle;
 		ioctl_t ioctl;
+		// The data and sense buffers of a submitted command must remain valid until the command has been completed.
+		submit_t submit;
+		complete_t complete;
+		size_t queue_depth;
 
 		protected:
 	};
 
 	auto create_detail(
 	) -> Detail;
+
+	auto create_synchronous_detail(
+		const get_handle_t& get_handle,
+		const ioctl_t& ioctl
+	) -> Detail;
+
+	auto create_queued_detail(
+		const Detail& detail,
+		size_t queue_depth
+	) -> Detail;
 }
 }
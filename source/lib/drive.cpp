@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <utility>
 #include "accuraterip.h"
 #include "bcd.h"
 #include "byteswap.h"
@@ -15,19 +16,61 @@
 
 namespace overdrive {
 namespace drive {
+	PendingSectorRange::PendingSectorRange(
+		void* handle,
+		const detail::complete_t& complete,
+		const std::shared_ptr<memory::BufferPool>& buffer_pool,
+		si_t first_absolute_index,
+		size_t sector_count
+	) {
+		this->handle = handle;
+		this->complete = complete;
+		this->buffer_pool = buffer_pool;
+		this->first_absolute_index = first_absolute_index;
+		this->sector_count = sector_count;
+		this->next_sector_offset = 0;
+	}
+
+	PendingSectorRange::PendingSectorRange(
+		PendingSectorRange&& other
+	) {
+		this->handle = other.handle;
+		this->complete = std::move(other.complete);
+		this->buffer_pool = std::move(other.buffer_pool);
+		this->first_absolute_index = other.first_absolute_index;
+		this->sector_count = other.sector_count;
+		this->next_sector_offset = other.next_sector_offset;
+		this->first_failed_sector_offset = other.first_failed_sector_offset;
+		this->exception = std::move(other.exception);
+		this->commands = std::move(other.commands);
+		other.commands.clear();
+	}
+
+	PendingSectorRange::~PendingSectorRange(
+	) {
+		for (auto& command : this->commands) {
+			try {
+				this->complete(this->handle, command.request_id);
+			} catch (...) {}
+			this->buffer_pool->release(command.buffer);
+		}
+	}
+
 	Drive::Drive(
 		void* handle,
 		std::optional<size_t> sector_data_offset,
 		std::optional<size_t> subchannels_data_offset,
 		std::optional<size_t> c2_data_offset,
-		const detail::ioctl_t& ioctl
+		const detail::Detail& detail
 	) {
 		this->handle = handle;
 		this->sector_data_offset = sector_data_offset;
 		this->subchannels_data_offset = subchannels_data_offset;
 		this->c2_data_offset = c2_data_offset;
-		this->ioctl = ioctl;
+		this->detail = detail;
 		this->page_masks = this->read_all_pages_with_control(cdb::ModeSensePageControl::CHANGABLE_VALUES);
+		this->max_sectors_per_read = this->determine_max_sectors_per_read();
+		this->buffer_pool = std::make_shared<memory::BufferPool>(this->max_sectors_per_read * cdb::READ_CD_LENGTH, TRANSFER_BUFFER_ALIGNMENT);
 	}
 
 	auto Drive::detect_subchannel_timing_offset(
@@ -75,6 +118,16 @@ namespace drive {
 		return this->c2_data_offset;
 	}
 
+	auto Drive::get_max_sectors_per_read(
+	) const -> size_t {
+		return this->max_sectors_per_read;
+	}
+
+	auto Drive::get_queue_depth(
+	) const -> size_t {
+		return std::max<size_t>(1, this->detail.queue_depth);
+	}
+
 	auto Drive::determine_track_type(
 		const cdb::ReadTOCResponseFullTOC& toc,
 		ui_t track_index
@@ -129,7 +182,7 @@ namespace drive {
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
 		cdb.format = cdb::ReadTOCFormat::NORMAL_TOC;
 		cdb.time = 1;
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -143,7 +196,7 @@ namespace drive {
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
 		cdb.format = cdb::ReadTOCFormat::SESSION_INFO;
 		cdb.time = 1;
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -157,7 +210,7 @@ namespace drive {
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
 		cdb.format = cdb::ReadTOCFormat::FULL_TOC;
 		cdb.time = 1;
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -171,7 +224,7 @@ namespace drive {
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
 		cdb.format = cdb::ReadTOCFormat::PMA;
 		cdb.time = 1;
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -185,7 +238,7 @@ namespace drive {
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
 		cdb.format = cdb::ReadTOCFormat::ATIP;
 		cdb.time = 1;
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -199,7 +252,7 @@ namespace drive {
 		auto data = cdb::ModeSenseReadWriteErrorRecoveryModePageResponse();
 		cdb.page_code = cdb::SensePage::READ_WRITE_ERROR_RECOVERY_MODE_PAGE;
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -216,7 +269,7 @@ namespace drive {
 		cdb.parameter_list_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
 		data.header.mode_data_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data) - sizeof(data.header.mode_data_length_be));
 		data.page = page;
-		auto status = this->ioctl(handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, true);
+		auto status = this->detail.ioctl(handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, true);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -229,7 +282,7 @@ namespace drive {
 		auto data = cdb::ModeSenseCachingModePageResponse();
 		cdb.page_code = cdb::SensePage::CACHING_MODE_PAGE;
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -246,7 +299,7 @@ namespace drive {
 		cdb.parameter_list_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
 		data.header.mode_data_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data) - sizeof(data.header.mode_data_length_be));
 		data.page = page;
-		auto status = this->ioctl(handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, true);
+		auto status = this->detail.ioctl(handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, true);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -259,7 +312,7 @@ namespace drive {
 		auto data = cdb::ModeSenseCapabilitiesAndMechanicalStatusPageResponse();
 		cdb.page_code = cdb::SensePage::CAPABILITIES_AND_MECHANICAL_STATUS_PAGE;
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -271,7 +324,7 @@ namespace drive {
 		auto cdb = cdb::Inquiry6();
 		auto data = cdb::StandardInquiryResponse();
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(sizeof(data));
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(&data), sizeof(data), nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -286,7 +339,7 @@ namespace drive {
 	auto Drive::test_unit_ready(
 	) const -> bool_t {
 		auto cdb = cdb::TestUnitReady6();
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), nullptr, 0, nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), nullptr, 0, nullptr, false);
 		return status == scsi::StatusCode::GOOD;
 	}
 
@@ -296,26 +349,7 @@ namespace drive {
 		pointer<array<cd::SUBCHANNELS_LENGTH, byte_t>> subchannels_data,
 		pointer<array<cd::C2_LENGTH, byte_t>> c2_data
 	) const -> void {
-		auto cdb = cdb::ReadCDMSF12();
-		cdb.expected_sector_type = cdb::ReadCD12ExpectedSectorType::ANY;
-		cdb.start_address = cd::get_address_from_sector(absolute_index);
-		cdb.end_address_exclusive = cd::get_address_from_sector(absolute_index + 1);
-		cdb.errors = cdb::ReadCD12Errors::C2_ERROR_BLOCK_DATA;
-		cdb.edc_and_ecc = 1;
-		cdb.user_data = 1;
-		cdb.header_codes = cdb::ReadCD12HeaderCodes::ALL_HEADERS;
-		cdb.sync = 1;
-		cdb.subchannel_selection_bits = cdb::ReadCD12SubchanelBits::RAW;
-		array<255, byte_t> sense;
-		auto buffer = std::array<byte_t, cdb::READ_CD_LENGTH>();
-		auto status = this->ioctl(handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(buffer.data()), sizeof(buffer), &sense, false);
-		if (status != scsi::StatusCode::GOOD) {
-			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
-		}
-		if (sense[0] == sense::ResponseCodes::FIXED_CURRENT) {
-			auto& fixed_format = *reinterpret_cast<sense::FixedFormat*>(&sense);
-			OVERDRIVE_LOG("Sense info 0x{:0>2X} 0x{:0>2X} 0x{:0>2X}!", size_t(fixed_format.sense_key), size_t(fixed_format.additional_sense_code), size_t(fixed_format.additional_sense_code_qualifier));
-		}
+		auto buffer = this->read_cd(absolute_index, 1);
 		if (sector_data != nullptr) {
 			if (!this->sector_data_offset) {
 				OVERDRIVE_THROW(exceptions::MissingValueException("sector data offset"));
@@ -336,6 +370,77 @@ namespace drive {
 		}
 	}
 
+	auto Drive::read_absolute_sector_range(
+		si_t first_absolute_index,
+		size_t sector_count,
+		const read_sector_range_callback_t& callback
+	) const -> void {
+		auto range = this->submit_absolute_sector_range(first_absolute_index, sector_count);
+		this->complete_absolute_sector_range(range, callback);
+	}
+
+	auto Drive::submit_absolute_sector_range(
+		si_t first_absolute_index,
+		size_t sector_count
+	) const -> PendingSectorRange {
+		if (!this->sector_data_offset) {
+			OVERDRIVE_THROW(exceptions::MissingValueException("sector data offset"));
+		}
+		if (!this->subchannels_data_offset) {
+			OVERDRIVE_THROW(exceptions::MissingValueException("subchannels data offset"));
+		}
+		if (!this->c2_data_offset) {
+			OVERDRIVE_THROW(exceptions::MissingValueException("c2 data offset"));
+		}
+		auto range = PendingSectorRange(this->handle, this->detail.complete, this->buffer_pool, first_absolute_index, sector_count);
+		this->submit_read_cd_commands(range);
+		return range;
+	}
+
+	auto Drive::complete_absolute_sector_range(
+		PendingSectorRange& range,
+		const read_sector_range_callback_t& callback
+	) const -> void {
+		// Commands are completed in submission order and the queue is refilled as commands complete.
+		while (!range.commands.empty()) {
+			auto status = scsi::StatusCode::CHECK_CONDITION;
+			try {
+				status = this->detail.complete(this->handle, range.commands.front().request_id);
+			} catch (...) {
+				if (!range.exception) {
+					range.exception = std::current_exception();
+				}
+			}
+			auto command = range.commands.front();
+			range.commands.pop_front();
+			if (status == scsi::StatusCode::GOOD && !range.first_failed_sector_offset) {
+				this->submit_read_cd_commands(range);
+				this->log_read_cd_sense(command.sense);
+				try {
+					for (auto sector_offset = size_t(0); sector_offset < command.sector_count; sector_offset += 1) {
+						auto data = command.buffer + sector_offset * cdb::READ_CD_LENGTH;
+						auto& sector_data = *reinterpret_cast<pointer<array<cd::SECTOR_LENGTH, byte_t>>>(data + this->sector_data_offset.value());
+						auto& subchannels_data = *reinterpret_cast<pointer<array<cd::SUBCHANNELS_LENGTH, byte_t>>>(data + this->subchannels_data_offset.value());
+						auto& c2_data = *reinterpret_cast<pointer<array<cd::C2_LENGTH, byte_t>>>(data + this->c2_data_offset.value());
+						callback(command.sector_offset + sector_offset, sector_data, subchannels_data, c2_data);
+					}
+				} catch (...) {
+					this->buffer_pool->release(command.buffer);
+					throw;
+				}
+			} else if (!range.first_failed_sector_offset) {
+				range.first_failed_sector_offset = command.sector_offset;
+			}
+			this->buffer_pool->release(command.buffer);
+		}
+		if (range.exception) {
+			std::rethrow_exception(range.exception);
+		}
+		if (range.first_failed_sector_offset) {
+			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
+		}
+	}
+
 	auto Drive::read_drive_info(
 	) const -> disc::DriveInfo {
 		auto standard_inquiry = this->read_standard_inquiry();
@@ -469,6 +574,86 @@ namespace drive {
 		}
 	}
 
+	auto Drive::determine_max_sectors_per_read(
+	) const -> size_t {
+		if (!this->page_masks.contains(cdb::SensePage::CAPABILITIES_AND_MECHANICAL_STATUS_PAGE)) {
+			return 1;
+		}
+		auto capabilites_and_mechanical_status_page = this->read_capabilites_and_mechanical_status_page();
+		auto buffer_size = size_t(byteswap::byteswap16_on_little_endian_systems(capabilites_and_mechanical_status_page.buffer_size_supported_be)) * 1024;
+		auto transfer_length = std::min(buffer_size, MAX_READ_TRANSFER_LENGTH);
+		return std::max<size_t>(1, transfer_length / cdb::READ_CD_LENGTH);
+	}
+
+	auto Drive::submit_read_cd_commands(
+		PendingSectorRange& range
+	) const -> void {
+		auto queue_depth = this->get_queue_depth();
+		while (!range.first_failed_sector_offset && range.next_sector_offset < range.sector_count && range.commands.size() < queue_depth) {
+			auto sector_count = std::min(range.sector_count - range.next_sector_offset, this->max_sectors_per_read);
+			auto cdb = this->create_read_cd_cdb(range.first_absolute_index + si_t(range.next_sector_offset), sector_count);
+			auto& command = range.commands.emplace_back();
+			command.sector_offset = range.next_sector_offset;
+			command.sector_count = sector_count;
+			command.cdb = cdb;
+			command.buffer = this->buffer_pool->acquire();
+			try {
+				command.request_id = this->detail.submit(this->handle, reinterpret_cast<byte_t*>(&command.cdb), sizeof(command.cdb), command.buffer, sector_count * cdb::READ_CD_LENGTH, &command.sense, false);
+			} catch (...) {
+				this->buffer_pool->release(command.buffer);
+				range.commands.pop_back();
+				range.first_failed_sector_offset = range.next_sector_offset;
+				range.exception = std::current_exception();
+				break;
+			}
+			range.next_sector_offset += sector_count;
+		}
+	}
+
+	auto Drive::create_read_cd_cdb(
+		si_t first_absolute_index,
+		size_t sector_count
+	) const -> cdb::ReadCDMSF12 {
+		if (sector_count < 1 || sector_count > this->max_sectors_per_read) {
+			OVERDRIVE_THROW(exceptions::InvalidValueException("sector count", sector_count, 1, this->max_sectors_per_read));
+		}
+		auto cdb = cdb::ReadCDMSF12();
+		cdb.expected_sector_type = cdb::ReadCD12ExpectedSectorType::ANY;
+		cdb.start_address = cd::get_address_from_sector(first_absolute_index);
+		cdb.end_address_exclusive = cd::get_address_from_sector(first_absolute_index + si_t(sector_count));
+		cdb.errors = cdb::ReadCD12Errors::C2_ERROR_BLOCK_DATA;
+		cdb.edc_and_ecc = 1;
+		cdb.user_data = 1;
+		cdb.header_codes = cdb::ReadCD12HeaderCodes::ALL_HEADERS;
+		cdb.sync = 1;
+		cdb.subchannel_selection_bits = cdb::ReadCD12SubchanelBits::RAW;
+		return cdb;
+	}
+
+	auto Drive::log_read_cd_sense(
+		const array<255, byte_t>& sense
+	) const -> void {
+		if (sense[0] == sense::ResponseCodes::FIXED_CURRENT) {
+			auto& fixed_format = *reinterpret_cast<const sense::FixedFormat*>(&sense);
+			OVERDRIVE_LOG("Sense info 0x{:0>2X} 0x{:0>2X} 0x{:0>2X}!", size_t(fixed_format.sense_key), size_t(fixed_format.additional_sense_code), size_t(fixed_format.additional_sense_code_qualifier));
+		}
+	}
+
+	auto Drive::read_cd(
+		si_t first_absolute_index,
+		size_t sector_count
+	) const -> std::vector<byte_t> {
+		auto cdb = this->create_read_cd_cdb(first_absolute_index, sector_count);
+		array<255, byte_t> sense = {};
+		auto buffer = std::vector<byte_t>(sector_count * cdb::READ_CD_LENGTH);
+		auto status = this->detail.ioctl(handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), buffer.data(), buffer.size(), &sense, false);
+		if (status != scsi::StatusCode::GOOD) {
+			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
+		}
+		this->log_read_cd_sense(sense);
+		return buffer;
+	}
+
 	auto Drive::read_all_pages_with_control(
 		cdb::ModeSensePageControl::type page_control
 	) const -> std::map<cdb::SensePage::type, std::vector<byte_t>> {
@@ -477,7 +662,7 @@ namespace drive {
 		cdb.page_control = page_control;
 		cdb.page_code = cdb::SensePage::ALL_PAGES;
 		cdb.allocation_length_be = byteswap::byteswap16_on_little_endian_systems(65535);
-		auto status = this->ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(data.data()), 65535, nullptr, false);
+		auto status = this->detail.ioctl(this->handle, reinterpret_cast<byte_t*>(&cdb), sizeof(cdb), reinterpret_cast<byte_t*>(data.data()), 65535, nullptr, false);
 		if (status != scsi::StatusCode::GOOD) {
 			OVERDRIVE_THROW(exceptions::InvalidSCSIStatusException());
 		}
@@ -541,21 +726,21 @@ namespace drive {
 
 	auto create_drive(
 		void* handle,
-		const detail::ioctl_t& ioctl
+		const detail::Detail& detail
 	) -> Drive {
-		auto drive = Drive(handle, std::optional<size_t>(0), std::optional<size_t>(), std::optional<size_t>(), ioctl);
+		auto drive = Drive(handle, std::optional<size_t>(0), std::optional<size_t>(), std::optional<size_t>(), detail);
 		if (!drive.test_unit_ready()) {
 			OVERDRIVE_THROW(exceptions::ExpectedOpticalDiscException());
 		}
 		for (auto pass_index = size_t(0); pass_index < MAX_AUTO_DETECT_SETTINGS_PASSES; pass_index += 1) {
 			try {
-				auto drive = Drive(handle, offsetof(cdb::ReadCDResponseDataA, sector_data), offsetof(cdb::ReadCDResponseDataA, subchannels_data), offsetof(cdb::ReadCDResponseDataA, c2_data), ioctl);
+				auto drive = Drive(handle, offsetof(cdb::ReadCDResponseDataA, sector_data), offsetof(cdb::ReadCDResponseDataA, subchannels_data), offsetof(cdb::ReadCDResponseDataA, c2_data), detail);
 				auto subchannel_timing_offset = drive.detect_subchannel_timing_offset();
 				OVERDRIVE_LOG("Detected subchannel timing offset {}", subchannel_timing_offset);
 				return drive;
 			} catch (const exceptions::AutoDetectFailureException& e) {}
 			try {
-				auto drive = Drive(handle, offsetof(cdb::ReadCDResponseDataB, sector_data), offsetof(cdb::ReadCDResponseDataB, subchannels_data), offsetof(cdb::ReadCDResponseDataB, c2_data), ioctl);
+				auto drive = Drive(handle, offsetof(cdb::ReadCDResponseDataB, sector_data), offsetof(cdb::ReadCDResponseDataB, subchannels_data), offsetof(cdb::ReadCDResponseDataB, c2_data), detail);
 				auto subchannel_timing_offset = drive.detect_subchannel_timing_offset();
 				OVERDRIVE_LOG("Detected subchannel timing offset {}", subchannel_timing_offset);
 				return drive;
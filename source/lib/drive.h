@@ -1,12 +1,17 @@
 #pragma once
 
+#include <deque>
+#include <exception>
+#include <functional>
 #include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 #include "cd.h"
 #include "cdb.h"
 #include "detail.h"
 #include "disc.h"
+#include "memory.h"
 #include "shared.h"
 
 namespace overdrive {
@@ -14,6 +19,56 @@ namespace drive {
 	using namespace shared;
 
 	const auto MAX_AUTO_DETECT_SETTINGS_PASSES = size_t(10);
+	const auto MAX_READ_TRANSFER_LENGTH = size_t(65536);
+	const auto TRANSFER_BUFFER_ALIGNMENT = size_t(4096);
+
+	using read_sector_range_callback_t = std::function<void(size_t sector_offset, const array<cd::SECTOR_LENGTH, byte_t>& sector_data, const array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data, const array<cd::C2_LENGTH, byte_t>& c2_data)>;
+
+	class ReadCDCommand {
+		public:
+
+		size_t sector_offset;
+		size_t sector_count;
+		cdb::ReadCDMSF12 cdb;
+		byte_t* buffer;
+		array<255, byte_t> sense;
+		size_t request_id;
+
+		protected:
+	};
+
+	class PendingSectorRange {
+		public:
+
+		PendingSectorRange(
+			void* handle,
+			const detail::complete_t& complete,
+			const std::shared_ptr<memory::BufferPool>& buffer_pool,
+			si_t first_absolute_index,
+			size_t sector_count
+		);
+
+		// The commands are taken from the other range so that they are completed exactly once.
+		PendingSectorRange(
+			PendingSectorRange&& other
+		);
+
+		// Commands still in flight are completed and discarded in order to never release a buffer that is in use.
+		~PendingSectorRange(
+		);
+
+		void* handle;
+		detail::complete_t complete;
+		std::shared_ptr<memory::BufferPool> buffer_pool;
+		si_t first_absolute_index;
+		size_t sector_count;
+		size_t next_sector_offset;
+		std::optional<size_t> first_failed_sector_offset;
+		std::exception_ptr exception;
+		std::deque<ReadCDCommand> commands;
+
+		protected:
+	};
 
 	class Drive {
 		public:
@@ -23,7 +78,7 @@ namespace drive {
 			std::optional<size_t> sector_data_offset,
 			std::optional<size_t> subchannels_data_offset,
 			std::optional<size_t> c2_data_offset,
-			const detail::ioctl_t& ioctl
+			const detail::Detail& detail
 		);
 
 		auto detect_subchannel_timing_offset(
@@ -38,6 +93,12 @@ namespace drive {
 		auto get_c2_data_offset(
 		) const -> std::optional<size_t>;
 
+		auto get_max_sectors_per_read(
+		) const -> size_t;
+
+		auto get_queue_depth(
+		) const -> size_t;
+
 		auto determine_track_type(
 			const cdb::ReadTOCResponseFullTOC& toc,
 			ui_t track_index
@@ -91,6 +152,22 @@ namespace drive {
 			pointer<array<cd::C2_LENGTH, byte_t>> c2_data
 		) const -> void;
 
+		auto read_absolute_sector_range(
+			si_t first_absolute_index,
+			size_t sector_count,
+			const read_sector_range_callback_t& callback
+		) const -> void;
+
+		auto submit_absolute_sector_range(
+			si_t first_absolute_index,
+			size_t sector_count
+		) const -> PendingSectorRange;
+
+		auto complete_absolute_sector_range(
+			PendingSectorRange& range,
+			const read_sector_range_callback_t& callback
+		) const -> void;
+
 		auto read_drive_info(
 		) const -> disc::DriveInfo;
 
@@ -103,6 +180,27 @@ namespace drive {
 
 		protected:
 
+		auto determine_max_sectors_per_read(
+		) const -> size_t;
+
+		auto submit_read_cd_commands(
+			PendingSectorRange& range
+		) const -> void;
+
+		auto create_read_cd_cdb(
+			si_t first_absolute_index,
+			size_t sector_count
+		) const -> cdb::ReadCDMSF12;
+
+		auto log_read_cd_sense(
+			const array<255, byte_t>& sense
+		) const -> void;
+
+		auto read_cd(
+			si_t first_absolute_index,
+			size_t sector_count
+		) const -> std::vector<byte_t>;
+
 		auto read_all_pages_with_control(
 			cdb::ModeSensePageControl::type page_control
 		) const -> std::map<cdb::SensePage::type, std::vector<byte_t>>;
@@ -122,13 +220,15 @@ namespace drive {
 		std::optional<size_t> sector_data_offset;
 		std::optional<size_t> subchannels_data_offset;
 		std::optional<size_t> c2_data_offset;
-		detail::ioctl_t ioctl;
+		detail::Detail detail;
 		std::map<cdb::SensePage::type, std::vector<byte_t>> page_masks;
+		size_t max_sectors_per_read;
+		std::shared_ptr<memory::BufferPool> buffer_pool;
 	};
 
 	auto create_drive(
 		void* handle,
-		const detail::ioctl_t& ioctl
+		const detail::Detail& detail
 	) -> Drive;
 }
 }
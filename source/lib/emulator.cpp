@@ -307,6 +307,8 @@ namespace emulator {
 			if (data_size < size) {
 				return scsi::StatusCode::CHECK_CONDITION;
 			}
+			// The image adapter does not provide c2 data so the entire range is cleared beforehand.
+			std::memset(data, 0, size);
 			auto offset = size_t(0);
 			for (auto sector_index = start_sector; sector_index < end_sector_exclusive; sector_index += 1) {
 				auto success = image_adapter.read_sector_data(handle, data + offset, sector_size, sector_index);
@@ -371,10 +373,7 @@ namespace emulator {
 		auto ioctl = [&, image_adapter](void* handle, byte_t* cdb, size_t cdb_size, byte_t* data, size_t data_size, pointer<array<255, byte_t>> sense, bool_t write_to_device) -> scsi::StatusCode::type {
 			return internal::ioctl(handle, cdb, cdb_size, data, data_size, sense, write_to_device, image_adapter);
 		};
-		return {
-			get_handle,
-			ioctl
-		};
+		return detail::create_synchronous_detail(get_handle, ioctl);
 	}
 }
 }
@@ -127,20 +127,15 @@ namespace exceptions {
 		size_t code
 	): OverdriveException(std::format("Expected WINAPI to not return error code {}!", code)) {}
 
+	LinuxException::LinuxException(
+		size_t code
+	): OverdriveException(std::format("Expected Linux API to not return error code {}!", code)) {}
+
 	CompressionException::CompressionException(
 		const std::string& message
 	): OverdriveException(message) {}
 
-	CompressedSizeExceededUncompressedSizeException::CompressedSizeExceededUncompressedSizeException(
-		size_t compressed_byte_count,
-		size_t uncompressed_byte_count
-	): CompressionException(std::format("Expected compressed size of {} to not exceed the uncompressed size of {}!", compressed_byte_count, uncompressed_byte_count)) {}
-
 	CompressionValidationError::CompressionValidationError(
 	): CompressionException(std::format("Expected the decompressed data to be identical to the uncompressed data!")) {}
-
-	BitWriterSizeExceededError::BitWriterSizeExceededError(
-		size_t max_size
-	): OverdriveException(std::format("Expected BitWriter size not to exceed {} bytes!", max_size)) {}
 }
 }
@@ -341,22 +341,21 @@ namespace exceptions {
 		protected:
 	};
 
-	class CompressionException: public OverdriveException {
+	class LinuxException: public OverdriveException {
 		public:
 
-		CompressionException(
-			const std::string& message
+		LinuxException(
+			size_t code
 		);
 
 		protected:
 	};
 
-	class CompressedSizeExceededUncompressedSizeException: public CompressionException {
+	class CompressionException: public OverdriveException {
 		public:
 
-		CompressedSizeExceededUncompressedSizeException(
-			size_t compressed_byte_count,
-			size_t uncompressed_byte_count
+		CompressionException(
+			const std::string& message
 		);
 
 		protected:
@@ -370,16 +369,6 @@ namespace exceptions {
 
 		protected:
 	};
-
-	class BitWriterSizeExceededError: public OverdriveException {
-		public:
-
-		BitWriterSizeExceededError(
-			size_t max_size
-		);
-
-		protected:
-	};
 }
 }
 
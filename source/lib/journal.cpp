@@ -0,0 +1,198 @@
+#include "journal.h"
+
+#include <cstring>
+#include <filesystem>
+#include "exceptions.h"
+#include "memory.h"
+
+namespace overdrive {
+namespace journal {
+	auto compute_fingerprint(
+		const disc::DiscInfo& disc_info,
+		si_t read_correction
+	) -> ui64_t {
+		auto fingerprint = memory::hash(&read_correction, sizeof(read_correction), 0);
+		for (const auto& point : disc::get_disc_points(disc_info)) {
+			fingerprint = memory::hash(&point.entry, sizeof(point.entry), fingerprint);
+		}
+		return fingerprint;
+	}
+
+	Journal::Journal(
+		const std::string& path,
+		ui64_t fingerprint,
+		bool_t resume
+	) {
+		this->path = path;
+		this->fingerprint = fingerprint;
+		this->handle = nullptr;
+		this->end_offset = 0;
+		if (resume && std::filesystem::exists(path)) {
+			this->handle = std::fopen(path.c_str(), "rb+");
+			if (this->handle == nullptr) {
+				OVERDRIVE_THROW(exceptions::IOOpenException(path));
+			}
+			try {
+				this->load();
+			} catch (...) {
+				std::fclose(this->handle);
+				throw;
+			}
+			OVERDRIVE_LOG("Resuming from journal \"{}\" containing {} sectors", path, this->entries.size());
+		} else {
+			this->handle = std::fopen(path.c_str(), "wb+");
+			if (this->handle == nullptr) {
+				OVERDRIVE_THROW(exceptions::IOOpenException(path));
+			}
+			auto file_header = FileHeader();
+			file_header.entry_length = sizeof(Entry);
+			file_header.payload_length = PAYLOAD_LENGTH;
+			file_header.fingerprint = fingerprint;
+			if (std::fwrite(&file_header, sizeof(file_header), 1, this->handle) != 1) {
+				std::fclose(this->handle);
+				OVERDRIVE_THROW(exceptions::IOWriteException(path));
+			}
+			this->end_offset = sizeof(file_header);
+		}
+	}
+
+	Journal::~Journal(
+	) {
+		if (this->handle != nullptr) {
+			std::fclose(this->handle);
+		}
+	}
+
+	auto Journal::contains(
+		si_t sector_index
+	) const -> bool_t {
+		return this->entries.contains(sector_index);
+	}
+
+	auto Journal::read(
+		si_t sector_index,
+		array<cd::SECTOR_LENGTH, byte_t>& sector_data,
+		array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data
+	) const -> Entry {
+		auto iterator = this->entries.find(sector_index);
+		if (iterator == this->entries.end()) {
+			OVERDRIVE_THROW(exceptions::MissingValueException("journal entry"));
+		}
+		auto& entry = iterator->second;
+		std::fseek(this->handle, entry.payload_absolute_offset, SEEK_SET);
+		if (std::fread(sector_data, sizeof(sector_data), 1, this->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOReadException(this->path));
+		}
+		if (std::fread(subchannels_data, sizeof(subchannels_data), 1, this->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOReadException(this->path));
+		}
+		return entry;
+	}
+
+	auto Journal::append(
+		si_t sector_index,
+		const array<cd::SECTOR_LENGTH, byte_t>& sector_data,
+		const array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data,
+		bool_t is_readable,
+		size_t counter
+	) -> void {
+		auto entry = Entry();
+		entry.payload_absolute_offset = this->end_offset + sizeof(Entry);
+		entry.sector_index = sector_index;
+		entry.counter = counter;
+		entry.readability = is_readable ? Readability::READABLE : Readability::UNREADABLE;
+		// Records are always written at the end of the last complete record which discards any record left incomplete by an interruption.
+		std::fseek(this->handle, this->end_offset, SEEK_SET);
+		if (std::fwrite(&entry, sizeof(entry), 1, this->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOWriteException(this->path));
+		}
+		if (std::fwrite(sector_data, sizeof(sector_data), 1, this->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOWriteException(this->path));
+		}
+		if (std::fwrite(subchannels_data, sizeof(subchannels_data), 1, this->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOWriteException(this->path));
+		}
+		this->end_offset += sizeof(Entry) + PAYLOAD_LENGTH;
+		this->entries[sector_index] = entry;
+	}
+
+	auto Journal::flush(
+	) -> void {
+		if (std::fflush(this->handle) != 0) {
+			OVERDRIVE_THROW(exceptions::IOWriteException(this->path));
+		}
+	}
+
+	auto Journal::erase(
+		si_t sector_index
+	) -> void {
+		auto iterator = this->entries.find(sector_index);
+		if (iterator == this->entries.end()) {
+			return;
+		}
+		auto entry = iterator->second;
+		entry.readability = Readability::ERASED;
+		std::fseek(this->handle, entry.payload_absolute_offset - sizeof(Entry), SEEK_SET);
+		if (std::fwrite(&entry, sizeof(entry), 1, this->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOWriteException(this->path));
+		}
+		this->entries.erase(iterator);
+	}
+
+	auto Journal::discard(
+	) -> void {
+		std::fclose(this->handle);
+		this->handle = nullptr;
+		this->entries.clear();
+		std::filesystem::remove(this->path);
+	}
+
+	auto Journal::load(
+	) -> void {
+		auto file_header = FileHeader();
+		std::fseek(this->handle, 0, SEEK_SET);
+		if (std::fread(&file_header, sizeof(file_header), 1, this->handle) != 1) {
+			OVERDRIVE_THROW(exceptions::IOReadException(this->path));
+		}
+		auto expected_file_header = FileHeader();
+		if (std::memcmp(file_header.identifier, expected_file_header.identifier, sizeof(file_header.identifier)) != 0) {
+			OVERDRIVE_THROW(exceptions::UnsupportedValueException("journal identifier"));
+		}
+		if (file_header.major_version != MAJOR_VERSION) {
+			OVERDRIVE_THROW(exceptions::InvalidValueException("journal major version", file_header.major_version, MAJOR_VERSION, MAJOR_VERSION));
+		}
+		if (file_header.header_length != sizeof(FileHeader)) {
+			OVERDRIVE_THROW(exceptions::InvalidValueException("journal header length", file_header.header_length, sizeof(FileHeader), sizeof(FileHeader)));
+		}
+		if (file_header.entry_length != sizeof(Entry)) {
+			OVERDRIVE_THROW(exceptions::InvalidValueException("journal entry length", file_header.entry_length, sizeof(Entry), sizeof(Entry)));
+		}
+		if (file_header.payload_length != PAYLOAD_LENGTH) {
+			OVERDRIVE_THROW(exceptions::InvalidValueException("journal payload length", file_header.payload_length, PAYLOAD_LENGTH, PAYLOAD_LENGTH));
+		}
+		// Sectors extracted from another disc or using another read offset correction must never be resumed from.
+		if (file_header.fingerprint != this->fingerprint) {
+			OVERDRIVE_THROW(exceptions::UnsupportedValueException("journal fingerprint"));
+		}
+		this->end_offset = file_header.header_length;
+		auto file_length = std::filesystem::file_size(this->path);
+		while (this->end_offset + sizeof(Entry) + PAYLOAD_LENGTH <= file_length) {
+			auto entry = Entry();
+			std::fseek(this->handle, this->end_offset, SEEK_SET);
+			if (std::fread(&entry, sizeof(entry), 1, this->handle) != 1) {
+				OVERDRIVE_THROW(exceptions::IOReadException(this->path));
+			}
+			if (entry.payload_absolute_offset != this->end_offset + sizeof(Entry)) {
+				break;
+			}
+			// Unreadable sectors are not loaded so that resuming extracts them again.
+			if (entry.readability == Readability::READABLE) {
+				this->entries[entry.sector_index] = entry;
+			} else {
+				this->entries.erase(entry.sector_index);
+			}
+			this->end_offset += sizeof(Entry) + PAYLOAD_LENGTH;
+		}
+	}
+}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdio>
+#include <map>
+#include <string>
+#include "cd.h"
+#include "disc.h"
+#include "shared.h"
+
+namespace overdrive {
+namespace journal {
+	using namespace shared;
+
+	const auto MAJOR_VERSION = size_t(1);
+	const auto MINOR_VERSION = size_t(0);
+
+	namespace Readability {
+		using type = ui08_t;
+
+		const auto UNREADABLE = type(0x00);
+		const auto READABLE = type(0x01);
+		const auto ERASED = type(0x02);
+	}
+
+	#pragma pack(push, 1)
+
+	struct FileHeader {
+		ch08_t identifier[16] = "OVERDRIVE JRNL"; // Zero-terminated.
+		ui08_t major_version = MAJOR_VERSION;
+		ui08_t minor_version = MINOR_VERSION;
+		ui16_t header_length = sizeof(FileHeader);
+		ui16_t entry_length;
+		ui16_t payload_length;
+		ui64_t fingerprint;
+	};
+
+	static_assert(sizeof(FileHeader) == 32);
+
+	struct Entry {
+		ui64_t payload_absolute_offset;
+		si32_t sector_index;
+		ui32_t counter;
+		Readability::type readability;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+		ui08_t : 8;
+	};
+
+	static_assert(sizeof(Entry) == 32);
+
+	#pragma pack(pop)
+
+	const auto PAYLOAD_LENGTH = size_t(cd::SECTOR_LENGTH + cd::SUBCHANNELS_LENGTH);
+
+	// Computes a fingerprint of the table of contents and of the read offset correction since both determine the extracted sectors.
+	auto compute_fingerprint(
+		const disc::DiscInfo& disc_info,
+		si_t read_correction
+	) -> ui64_t;
+
+	class Journal {
+		public:
+
+		// Journals created for another fingerprint are rejected when resuming.
+		Journal(
+			const std::string& path,
+			ui64_t fingerprint,
+			bool_t resume
+		);
+
+		Journal(
+			const Journal& other
+		) = delete;
+
+		~Journal(
+		);
+
+		auto contains(
+			si_t sector_index
+		) const -> bool_t;
+
+		auto read(
+			si_t sector_index,
+			array<cd::SECTOR_LENGTH, byte_t>& sector_data,
+			array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data
+		) const -> Entry;
+
+		auto append(
+			si_t sector_index,
+			const array<cd::SECTOR_LENGTH, byte_t>& sector_data,
+			const array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data,
+			bool_t is_readable,
+			size_t counter
+		) -> void;
+
+		auto flush(
+		) -> void;
+
+		// Marks the record of the sector as erased in place which prevents it from being loaded again.
+		auto erase(
+			si_t sector_index
+		) -> void;
+
+		auto discard(
+		) -> void;
+
+		protected:
+
+		auto load(
+		) -> void;
+
+		std::string path;
+		ui64_t fingerprint;
+		std::FILE* handle;
+		std::map<si_t, Entry> entries;
+		size_t end_offset;
+	};
+}
+}
@@ -0,0 +1,147 @@
+#include "lpc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace overdrive {
+namespace lpc {
+	namespace internal {
+	namespace {
+		auto get_expected_bits_per_residual(
+			fp64_t error,
+			size_t sample_count
+		) -> fp64_t {
+			if (error <= 0.0) {
+				return 0.0;
+			}
+			// The residuals are assumed to be Laplacian with the variance given by the prediction error.
+			auto bits = 0.5 * std::log2(0.5 * error / sample_count);
+			return std::max(bits, 0.0);
+		}
+	}
+	}
+
+	auto create_tukey_window(
+		size_t length,
+		fp64_t ratio
+	) -> std::vector<fp64_t> {
+		auto window = std::vector<fp64_t>(length, 1.0);
+		auto lobe_length = size_t(ratio * length / 2);
+		for (auto index = size_t(0); index < lobe_length; index += 1) {
+			auto weight = 0.5 - 0.5 * std::cos(std::numbers::pi * index / lobe_length);
+			window.at(index) = weight;
+			window.at(length - 1 - index) = weight;
+		}
+		return window;
+	}
+
+	auto compute_autocorrelation(
+		const si32_t* samples,
+		const fp64_t* window,
+		size_t count,
+		size_t max_order,
+		fp64_t* autocorrelation
+	) -> void {
+		auto windowed_samples = std::vector<fp64_t>(count);
+		for (auto sample_index = size_t(0); sample_index < count; sample_index += 1) {
+			windowed_samples[sample_index] = samples[sample_index] * window[sample_index];
+		}
+		for (auto lag = size_t(0); lag <= max_order; lag += 1) {
+			auto sum = 0.0;
+			for (auto sample_index = lag; sample_index < count; sample_index += 1) {
+				sum += windowed_samples[sample_index] * windowed_samples[sample_index - lag];
+			}
+			autocorrelation[lag] = sum;
+		}
+	}
+
+	auto compute_predictor_coefficients(
+		const fp64_t* autocorrelation,
+		size_t max_order,
+		array<MAX_ORDER, array<MAX_ORDER, fp64_t>>& coefficients,
+		array<MAX_ORDER, fp64_t>& errors
+	) -> size_t {
+		array<MAX_ORDER, fp64_t> reflected;
+		auto error = autocorrelation[0];
+		for (auto order_index = size_t(0); order_index < max_order; order_index += 1) {
+			if (error <= 0.0) {
+				return order_index;
+			}
+			auto reflection = 0.0 - autocorrelation[order_index + 1];
+			for (auto index = size_t(0); index < order_index; index += 1) {
+				reflection -= reflected[index] * autocorrelation[order_index - index];
+			}
+			reflection /= error;
+			reflected[order_index] = reflection;
+			for (auto index = size_t(0); index < order_index / 2; index += 1) {
+				auto value = reflected[index];
+				reflected[index] += reflection * reflected[order_index - 1 - index];
+				reflected[order_index - 1 - index] += reflection * value;
+			}
+			if (order_index % 2 == 1) {
+				reflected[order_index / 2] += reflected[order_index / 2] * reflection;
+			}
+			error *= 1.0 - reflection * reflection;
+			for (auto index = size_t(0); index <= order_index; index += 1) {
+				coefficients[order_index][index] = 0.0 - reflected[index];
+			}
+			errors[order_index] = error;
+		}
+		return max_order;
+	}
+
+	auto estimate_best_order(
+		const array<MAX_ORDER, fp64_t>& errors,
+		size_t order_count,
+		size_t sample_count,
+		size_t precision
+	) -> size_t {
+		auto best_order = size_t(1);
+		auto best_bits = 0.0;
+		for (auto order = size_t(1); order <= order_count; order += 1) {
+			auto bits = internal::get_expected_bits_per_residual(errors[order - 1], sample_count) * (sample_count - order) + order * precision;
+			if (order == 1 || bits < best_bits) {
+				best_order = order;
+				best_bits = bits;
+			}
+		}
+		return best_order;
+	}
+
+	auto quantize_coefficients(
+		const fp64_t* coefficients,
+		size_t order,
+		size_t precision,
+		size_t max_shift
+	) -> QuantizedPredictor {
+		auto predictor = QuantizedPredictor();
+		predictor.order = order;
+		predictor.precision = precision;
+		predictor.shift = 0;
+		auto max_coefficient = 0.0;
+		for (auto index = size_t(0); index < order; index += 1) {
+			max_coefficient = std::max(max_coefficient, std::abs(coefficients[index]));
+		}
+		if (max_coefficient > 0.0) {
+			// The largest coefficient is scaled to use every bit of the precision except the sign bit.
+			auto exponent = si_t(0);
+			std::frexp(max_coefficient, &exponent);
+			predictor.shift = size_t(std::clamp<si_t>(si_t(precision) - 1 - exponent, 0, si_t(max_shift)));
+		}
+		auto max_value = si32_t((1 << (precision - 1)) - 1);
+		auto min_value = si32_t(0 - (1 << (precision - 1)));
+		auto error = 0.0;
+		for (auto index = size_t(0); index < order; index += 1) {
+			error += coefficients[index] * fp64_t(size_t(1) << predictor.shift);
+			auto value = si32_t(std::lround(std::clamp<fp64_t>(error, min_value, max_value)));
+			predictor.coefficients[index] = value;
+			error -= value;
+		}
+		for (auto index = order; index < MAX_ORDER; index += 1) {
+			predictor.coefficients[index] = 0;
+		}
+		return predictor;
+	}
+}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+#include "shared.h"
+
+namespace overdrive {
+namespace lpc {
+	using namespace shared;
+
+	const auto MAX_ORDER = size_t(32);
+
+	class QuantizedPredictor {
+		public:
+
+		size_t order;
+		size_t precision;
+		size_t shift;
+		// The first coefficient is applied to the preceding sample.
+		array<MAX_ORDER, si32_t> coefficients;
+
+		protected:
+	};
+
+	// Creates a window that is flat in the middle and tapers to zero at both ends using cosine lobes spanning the ratio of the length.
+	auto create_tukey_window(
+		size_t length,
+		fp64_t ratio
+	) -> std::vector<fp64_t>;
+
+	// Computes the autocorrelation of the windowed samples for every lag from zero up to and including the max order.
+	auto compute_autocorrelation(
+		const si32_t* samples,
+		const fp64_t* window,
+		size_t count,
+		size_t max_order,
+		fp64_t* autocorrelation
+	) -> void;
+
+	// Computes the predictor coefficients for every order up to the max order using the Levinson-Durbin recursion.
+	// The coefficients of order n are stored in row n - 1 together with the prediction error. The number of orders computed is returned.
+	auto compute_predictor_coefficients(
+		const fp64_t* autocorrelation,
+		size_t max_order,
+		array<MAX_ORDER, array<MAX_ORDER, fp64_t>>& coefficients,
+		array<MAX_ORDER, fp64_t>& errors
+	) -> size_t;
+
+	// Estimates the order for which the residuals and the quantized coefficients require the fewest bits.
+	auto estimate_best_order(
+		const array<MAX_ORDER, fp64_t>& errors,
+		size_t order_count,
+		size_t sample_count,
+		size_t precision
+	) -> size_t;
+
+	// Quantizes the coefficients to signed integers of the given precision while carrying the quantization error over to the next coefficient.
+	auto quantize_coefficients(
+		const fp64_t* coefficients,
+		size_t order,
+		size_t precision,
+		size_t max_shift
+	) -> QuantizedPredictor;
+}
+}
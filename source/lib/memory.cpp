@@ -1,6 +1,8 @@
 #include "memory.h"
 
+#include <algorithm>
 #include <cstring>
+#include <new>
 
 namespace overdrive {
 namespace memory {
@@ -12,5 +14,70 @@ namespace memory {
 		auto buffer = reinterpret_cast<const byte_t*>(pointer);
 		return (buffer[0] == value) && std::memcmp(buffer, buffer + 1, size - 1) == 0;
 	}
+
+	auto hash(
+		const void* pointer,
+		size_t size,
+		ui64_t seed
+	) -> ui64_t {
+		auto buffer = reinterpret_cast<const byte_t*>(pointer);
+		auto state = seed ^ (ui64_t(size) * 0x9E3779B97F4A7C15);
+		auto offset = size_t(0);
+		// The buffer is consumed eight bytes at a time with the final bytes padded with zeroes.
+		while (offset < size) {
+			auto word = ui64_t(0);
+			std::memcpy(&word, buffer + offset, std::min<size_t>(sizeof(word), size - offset));
+			word *= 0xBF58476D1CE4E5B9;
+			word ^= word >> 31;
+			state = (state ^ word) * 0x94D049BB133111EB;
+			state ^= state >> 29;
+			offset += sizeof(word);
+		}
+		state ^= state >> 32;
+		state *= 0xD6E8FEB86659FD93;
+		state ^= state >> 32;
+		return state;
+	}
+
+	BufferPool::BufferPool(
+		size_t buffer_size,
+		size_t alignment
+	) {
+		this->buffer_size = buffer_size;
+		this->alignment = alignment;
+	}
+
+	BufferPool::~BufferPool(
+	) {
+		for (auto buffer : this->buffers) {
+			::operator delete(buffer, std::align_val_t(this->alignment));
+		}
+	}
+
+	auto BufferPool::acquire(
+	) -> byte_t* {
+		auto lock = std::lock_guard<std::mutex>(this->mutex);
+		// Buffers are allocated lazily and kept for reuse until the pool is destroyed.
+		if (this->free_buffers.empty()) {
+			auto buffer = static_cast<byte_t*>(::operator new(this->buffer_size, std::align_val_t(this->alignment)));
+			this->buffers.push_back(buffer);
+			return buffer;
+		}
+		auto buffer = this->free_buffers.back();
+		this->free_buffers.pop_back();
+		return buffer;
+	}
+
+	auto BufferPool::release(
+		byte_t* buffer
+	) -> void {
+		auto lock = std::lock_guard<std::mutex>(this->mutex);
+		this->free_buffers.push_back(buffer);
+	}
+
+	auto BufferPool::get_buffer_size(
+	) const -> size_t {
+		return this->buffer_size;
+	}
 }
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+#include <vector>
 #include "shared.h"
 
 namespace overdrive {
@@ -11,5 +13,45 @@ namespace memory {
 		size_t size,
 		byte_t value
 	) -> bool_t;
+
+	auto hash(
+		const void* pointer,
+		size_t size,
+		ui64_t seed
+	) -> ui64_t;
+
+	class BufferPool {
+		public:
+
+		BufferPool(
+			size_t buffer_size,
+			size_t alignment
+		);
+
+		BufferPool(
+			const BufferPool& other
+		) = delete;
+
+		~BufferPool(
+		);
+
+		auto acquire(
+		) -> byte_t*;
+
+		auto release(
+			byte_t* buffer
+		) -> void;
+
+		auto get_buffer_size(
+		) const -> size_t;
+
+		protected:
+
+		size_t buffer_size;
+		size_t alignment;
+		std::mutex mutex;
+		std::vector<byte_t*> buffers;
+		std::vector<byte_t*> free_buffers;
+	};
 }
 }
@@ -6,12 +6,15 @@
 #include <cstdio>
 #include <cstring>
 #include <map>
-#include <thread>
+#include <optional>
 #include <vector>
 #include "bits.h"
 #include "cdda.h"
 #include "emulator.h"
 #include "exceptions.h"
+#include "lpc.h"
+#include "pool.h"
+#include "simd.h"
 
 namespace overdrive {
 namespace odi {
@@ -21,7 +24,8 @@ namespace odi {
 		static const auto names = std::map<type, std::string>({
 			{ NONE, "NONE" },
 			{ RUN_LENGTH_ENCODING, "RUN_LENGTH_ENCODING" },
-			{ LOSSLESS_STEREO_AUDIO, "LOSSLESS_STEREO_AUDIO" }
+			{ LOSSLESS_STEREO_AUDIO, "LOSSLESS_STEREO_AUDIO" },
+			{ LOSSLESS_STEREO_AUDIO_LPC, "LOSSLESS_STEREO_AUDIO_LPC" }
 		});
 		static const auto fallback = std::string("???");
 		auto iterator = names.find(value);
@@ -31,6 +35,15 @@ namespace odi {
 		return iterator->second;
 	}
 
+	auto SectorDataCompressionMethod::get_minor_version(
+		type value
+	) -> size_t {
+		if (value == LOSSLESS_STEREO_AUDIO_LPC) {
+			return 1;
+		}
+		return 0;
+	}
+
 	auto SubchannelsDataCompressionMethod::name(
 		type value
 	) -> const std::string& {
@@ -85,169 +98,171 @@ namespace odi {
 		const auto BITS_PER_RICE_PARAMETER = size_t(sizeof(MAX_RICE_PARAMETER) * 8 - std::countl_zero(MAX_RICE_PARAMETER - 1));
 
 		auto deinterleave_channels(
-			const cdda::Sector& sector,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample>& channel_a,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample>& channel_b
+			const array<cd::SECTOR_LENGTH, byte_t>& sector_data,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t>& channel_a,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t>& channel_b
 		) -> void {
-			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
-				channel_a[sample_index] = sector.samples[sample_index * 2 + 0];
-				channel_b[sample_index] = sector.samples[sample_index * 2 + 1];
-			}
+			simd::deinterleave_samples(sector_data, channel_a, channel_b, cdda::STEREO_SAMPLES_PER_SECTOR);
 		}
 
 		auto reinterleave_channels(
-			cdda::Sector& sector,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, const cdda::Sample>& channel_a,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, const cdda::Sample>& channel_b
+			array<cd::SECTOR_LENGTH, byte_t>& sector_data,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& channel_a,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& channel_b
 		) -> void {
-			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
-				sector.samples[sample_index * 2 + 0] = channel_a[sample_index];
-				sector.samples[sample_index * 2 + 1] = channel_b[sample_index];
-			}
+			simd::interleave_samples(channel_a, channel_b, sector_data, cdda::STEREO_SAMPLES_PER_SECTOR);
 		}
 
 		auto decorrelate_spatially(
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_a,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_b
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& channel_a,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t>& channel_b
 		) -> void {
-			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
-				channel_b[sample_index].si -= channel_a[sample_index].si;
-			}
+			simd::subtract_samples(channel_b, channel_a, cdda::STEREO_SAMPLES_PER_SECTOR);
 		}
 
 		auto recorrelate_spatially(
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_a,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_b
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& channel_a,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t>& channel_b
 		) -> void {
-			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
-				channel_b[sample_index].si += channel_a[sample_index].si;
-			}
+			simd::add_samples(channel_b, channel_a, cdda::STEREO_SAMPLES_PER_SECTOR);
 		}
 
 		auto decorrelate_temporally(
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, const cdda::Sample>& samples,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample>& residuals,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& samples,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t>& residuals,
 			const Predictor& predictor
 		) -> void {
-			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
-				auto sample_index_reverse = cdda::STEREO_SAMPLES_PER_SECTOR - (sample_index + 1);
-				auto prediction = 0;
-				if (sample_index_reverse > 0) {
-					auto sample_m3 = samples[sample_index_reverse >= 3 ? sample_index_reverse - 3 : 0].si;
-					auto sample_m2 = samples[sample_index_reverse >= 2 ? sample_index_reverse - 2 : 0].si;
-					auto sample_m1 = samples[sample_index_reverse >= 1 ? sample_index_reverse - 1 : 0].si;
-					prediction = predictor.m3 * sample_m3 + predictor.m2 * sample_m2 + predictor.m1 * sample_m1;
-				}
-				auto sample = samples[sample_index_reverse].si;
-				auto residual = si16_t(sample - prediction);
-				residuals[sample_index_reverse].si = residual;
-			}
+			simd::compute_prediction_residuals(samples, residuals, cdda::STEREO_SAMPLES_PER_SECTOR, predictor.m3, predictor.m2, predictor.m1);
 		}
 
 		auto recorrelate_temporally(
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample>& samples,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, const cdda::Sample>& residuals,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t>& samples,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& residuals,
 			const Predictor& predictor
 		) -> void {
-			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
-				auto prediction = 0;
-				if (sample_index > 0) {
-					auto sample_m3 = samples[sample_index >= 3 ? sample_index - 3 : 0].si;
-					auto sample_m2 = samples[sample_index >= 2 ? sample_index - 2 : 0].si;
-					auto sample_m1 = samples[sample_index >= 1 ? sample_index - 1 : 0].si;
-					prediction = predictor.m3 * sample_m3 + predictor.m2 * sample_m2 + predictor.m1 * sample_m1;
-				}
-				auto residual = residuals[sample_index].si;
-				auto sample = si16_t(residual + prediction);
-				samples[sample_index].si = sample;
-			}
+			simd::apply_prediction_residuals(residuals, samples, cdda::STEREO_SAMPLES_PER_SECTOR, predictor.m3, predictor.m2, predictor.m1);
 		}
 
 		auto compress_sector_lossless_stereo_audio_channel_with_parameters(
 			bits::BitWriter bitwriter,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, const cdda::Sample>& samples,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& samples,
 			size_t rice_parameter,
 			size_t predictor_index
 		) -> bits::BitWriter {
 			auto& predictor = PREDICTORS.at(predictor_index);
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> residuals;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> residuals;
 			decorrelate_temporally(samples, residuals, predictor);
-			try {
-				bitwriter.append_bits(rice_parameter, BITS_PER_RICE_PARAMETER);
-				bitwriter.append_bits(predictor_index, BITS_PER_PREDICTOR_INDEX);
-				bits::compress_data_using_rice_coding(reinterpret_cast<si16_t*>(&residuals), cdda::STEREO_SAMPLES_PER_SECTOR, rice_parameter, bitwriter);
-			} catch (const exceptions::BitWriterSizeExceededError& e) {}
+			bitwriter.append_bits(rice_parameter, BITS_PER_RICE_PARAMETER);
+			bitwriter.append_bits(predictor_index, BITS_PER_PREDICTOR_INDEX);
+			bits::compress_data_using_rice_coding(residuals, cdda::STEREO_SAMPLES_PER_SECTOR, rice_parameter, bitwriter);
 			return bitwriter;
 		}
 
+		class RiceCodingCandidate {
+			public:
+
+			size_t predictor_index;
+			size_t rice_parameter;
+			size_t bit_count;
+
+			protected:
+		};
+
+		auto get_unsigned_residuals(
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& samples,
+			const Predictor& predictor,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, ui16_t>& unsigned_residuals
+		) -> size_t {
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> residuals;
+			decorrelate_temporally(samples, residuals, predictor);
+			return simd::zigzag_encode(residuals, unsigned_residuals, cdda::STEREO_SAMPLES_PER_SECTOR);
+		}
+
+		auto get_rice_coding_bit_count(
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const ui16_t>& unsigned_residuals,
+			size_t rice_parameter
+		) -> size_t {
+			return cdda::STEREO_SAMPLES_PER_SECTOR * (rice_parameter + 1) + simd::sum_shifted(unsigned_residuals, cdda::STEREO_SAMPLES_PER_SECTOR, rice_parameter);
+		}
+
+		auto select_rice_parameter(
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const ui16_t>& unsigned_residuals,
+			size_t sum
+		) -> RiceCodingCandidate {
+			// The optimal parameter for geometrically distributed values is close to the base two logarithm of their mean.
+			auto mean = sum / cdda::STEREO_SAMPLES_PER_SECTOR;
+			auto rice_parameter = std::min<size_t>(mean > 0 ? std::bit_width(mean) - 1 : 0, MAX_RICE_PARAMETER - 1);
+			auto bit_count = get_rice_coding_bit_count(unsigned_residuals, rice_parameter);
+			// The bit count is convex in the rice parameter so walking towards smaller counts finds the smallest optimal parameter.
+			while (rice_parameter > 0) {
+				auto lower_bit_count = get_rice_coding_bit_count(unsigned_residuals, rice_parameter - 1);
+				if (lower_bit_count > bit_count) {
+					break;
+				}
+				rice_parameter -= 1;
+				bit_count = lower_bit_count;
+			}
+			while (rice_parameter + 1 < MAX_RICE_PARAMETER) {
+				auto upper_bit_count = get_rice_coding_bit_count(unsigned_residuals, rice_parameter + 1);
+				if (upper_bit_count >= bit_count) {
+					break;
+				}
+				rice_parameter += 1;
+				bit_count = upper_bit_count;
+			}
+			return {
+				0,
+				rice_parameter,
+				bit_count
+			};
+		}
+
 		auto compress_sector_lossless_stereo_audio_channel(
 			bits::BitWriter bitwriter,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, const cdda::Sample>& samples
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si16_t>& samples
 		) -> bits::BitWriter {
-			auto thread_bitwriters = std::array<bits::BitWriter, MAX_RICE_PARAMETER>();
-			auto threads = std::array<std::thread, MAX_RICE_PARAMETER>();
-			for (auto thread_index = size_t(0); thread_index < MAX_RICE_PARAMETER; thread_index += 1) {
-				auto thread = std::thread([&, thread_index]() -> void {
-					auto rice_parameter = thread_index;
-					auto bitwriters = std::array<bits::BitWriter, PREDICTORS.size()>();
-					for (auto predictor_index = size_t(0); predictor_index < bitwriters.size(); predictor_index += 1) {
-						bitwriters.at(predictor_index) = std::move(compress_sector_lossless_stereo_audio_channel_with_parameters(bitwriter, samples, rice_parameter, predictor_index));
-					}
-					auto best_bitwriter_index = size_t(0);
-					for (auto bitwriter_index = size_t(1); bitwriter_index < bitwriters.size(); bitwriter_index += 1) {
-						if (bitwriters.at(bitwriter_index).get_size() < bitwriters.at(best_bitwriter_index).get_size()) {
-							best_bitwriter_index = bitwriter_index;
-						}
-					}
-					auto& best_bitwriter = bitwriters.at(best_bitwriter_index);
-					thread_bitwriters.at(thread_index) = std::move(best_bitwriter);
-				});
-				threads.at(thread_index) = std::move(thread);
-			}
-			for (auto thread_index = size_t(0); thread_index < threads.size(); thread_index += 1) {
-				threads.at(thread_index).join();
-			}
-			auto best_bitwriter_index = size_t(0);
-			for (auto thread_bitwriter_index = size_t(1); thread_bitwriter_index < thread_bitwriters.size(); thread_bitwriter_index += 1) {
-				if (thread_bitwriters.at(thread_bitwriter_index).get_size() < thread_bitwriters.at(best_bitwriter_index).get_size()) {
-					best_bitwriter_index = thread_bitwriter_index;
+			auto best_candidate = std::optional<RiceCodingCandidate>();
+			for (auto predictor_index = size_t(0); predictor_index < PREDICTORS.size(); predictor_index += 1) {
+				array<cdda::STEREO_SAMPLES_PER_SECTOR, ui16_t> unsigned_residuals;
+				auto sum = get_unsigned_residuals(samples, PREDICTORS.at(predictor_index), unsigned_residuals);
+				auto candidate = select_rice_parameter(unsigned_residuals, sum);
+				candidate.predictor_index = predictor_index;
+				// Ties are broken towards the smallest rice parameter and then the smallest predictor index.
+				if (!best_candidate || candidate.bit_count < best_candidate->bit_count || (candidate.bit_count == best_candidate->bit_count && candidate.rice_parameter < best_candidate->rice_parameter)) {
+					best_candidate = candidate;
 				}
 			}
-			auto& best_bitwriter = thread_bitwriters.at(best_bitwriter_index);
-			return best_bitwriter;
+			return compress_sector_lossless_stereo_audio_channel_with_parameters(bitwriter, samples, best_candidate->rice_parameter, best_candidate->predictor_index);
 		}
 
 		auto compress_sector_lossless_stereo_audio(
 			array<cd::SECTOR_LENGTH, byte_t>& target_sector_data
-		) -> size_t {
-			auto& sector = *reinterpret_cast<cdda::Sector*>(&target_sector_data);
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_a;
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_b;
-			deinterleave_channels(sector, channel_a, channel_b);
+		) -> std::optional<size_t> {
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> channel_a;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> channel_b;
+			deinterleave_channels(target_sector_data, channel_a, channel_b);
 			decorrelate_spatially(channel_a, channel_b);
-			auto bitwriter = bits::BitWriter(cd::SECTOR_LENGTH);
+			auto bitwriter = bits::BitWriter(cd::SECTOR_LENGTH - 1);
 			bitwriter = std::move(compress_sector_lossless_stereo_audio_channel(bitwriter, channel_a));
 			bitwriter = std::move(compress_sector_lossless_stereo_audio_channel(bitwriter, channel_b));
-			try {
-				bitwriter.flush_bits();
-			} catch (const exceptions::BitWriterSizeExceededError& e) {}
-			auto& buffer = bitwriter.get_buffer();
-			if (buffer.size() >= cd::SECTOR_LENGTH) {
-				OVERDRIVE_THROW(exceptions::CompressedSizeExceededUncompressedSizeException(buffer.size(), cd::SECTOR_LENGTH));
+			bitwriter.flush_bits();
+			if (bitwriter.is_size_exceeded()) {
+				return std::optional<size_t>();
 			}
+			auto& buffer = bitwriter.get_buffer();
 			std::memcpy(&target_sector_data, buffer.data(), buffer.size());
 			return buffer.size();
 		}
 
 		auto decompress_sector_lossless_stereo_audio_channel(
 			bits::BitReader& bitreader,
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample>& samples
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t>& samples
 		) -> void {
 			auto rice_parameter = bitreader.decode_bits(BITS_PER_RICE_PARAMETER);
 			auto predictor_index = bitreader.decode_bits(BITS_PER_PREDICTOR_INDEX);
 			auto& predictor = PREDICTORS.at(predictor_index);
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> residuals;
-			bits::decompress_data_using_rice_coding(reinterpret_cast<si16_t*>(&residuals), cdda::STEREO_SAMPLES_PER_SECTOR, rice_parameter, bitreader);
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> residuals;
+			bits::decompress_data_using_rice_coding(residuals, cdda::STEREO_SAMPLES_PER_SECTOR, rice_parameter, bitreader);
 			recorrelate_temporally(samples, residuals, predictor);
 		}
 
@@ -255,31 +270,389 @@ namespace odi {
 			array<cd::SECTOR_LENGTH, byte_t>& target_sector_data,
 			size_t compressed_byte_count
 		) -> void {
-			auto& sector = *reinterpret_cast<cdda::Sector*>(&target_sector_data);
 			auto original = std::vector<byte_t>(compressed_byte_count);
 			std::memcpy(original.data(), &target_sector_data, compressed_byte_count);
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_a;
-			array<cdda::STEREO_SAMPLES_PER_SECTOR, cdda::Sample> channel_b;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> channel_a;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> channel_b;
 			auto bitreader = bits::BitReader(original, 0);
 			decompress_sector_lossless_stereo_audio_channel(bitreader, channel_a);
 			decompress_sector_lossless_stereo_audio_channel(bitreader, channel_b);
 			recorrelate_spatially(channel_a, channel_b);
-			reinterleave_channels(sector, channel_a, channel_b);
+			reinterleave_channels(target_sector_data, channel_a, channel_b);
+		}
+
+		namespace StereoMode {
+			using type = ui08_t;
+
+			const auto INDEPENDENT = type(0);
+			const auto LEFT_SIDE = type(1);
+			const auto RIGHT_SIDE = type(2);
+			const auto MID_SIDE = type(3);
+		}
+
+		const auto BITS_PER_STEREO_MODE = size_t(2);
+		const auto MAX_FIXED_ORDER = size_t(4);
+		const auto BITS_PER_FIXED_ORDER = size_t(3);
+		const auto BITS_PER_LPC_ORDER = size_t(5);
+		const auto BITS_PER_LPC_PRECISION = size_t(4);
+		const auto BITS_PER_LPC_SHIFT = size_t(5);
+		const auto MAX_LPC_SHIFT = size_t(31);
+		// The precision balances the cost of storing the coefficients against the accuracy of the prediction for sectors of 588 samples.
+		const auto LPC_PRECISION = size_t(10);
+		const auto MAX_PARTITION_ORDER = size_t(5);
+		const auto BITS_PER_PARTITION_ORDER = size_t(3);
+		const auto MAX_PARTITION_RICE_PARAMETER = size_t(32);
+		const auto BITS_PER_PARTITION_RICE_PARAMETER = size_t(sizeof(MAX_PARTITION_RICE_PARAMETER) * 8 - std::countl_zero(MAX_PARTITION_RICE_PARAMETER - 1));
+		const auto LPC_WINDOW = lpc::create_tukey_window(cdda::STEREO_SAMPLES_PER_SECTOR, 0.5);
+
+		const auto FIXED_PREDICTORS = std::array<lpc::QuantizedPredictor, MAX_FIXED_ORDER + 1>({
+			{ 0, 0, 0, {} }, // None
+			{ 1, 0, 0, { 1 } }, // Constant extrapolation
+			{ 2, 0, 0, { 2, -1 } }, // Linear extrapolation
+			{ 3, 0, 0, { 3, -3, 1 } }, // Quadratic extrapolation
+			{ 4, 0, 0, { 4, -6, 4, -1 } } // Cubic extrapolation
+		});
+
+		class LPCSubframe {
+			public:
+
+			bool_t is_lpc;
+			lpc::QuantizedPredictor predictor;
+			size_t partition_order;
+			array<(1 << MAX_PARTITION_ORDER), size_t> rice_parameters;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, ui32_t> unsigned_residuals;
+			size_t bit_count;
+
+			protected:
+		};
+
+		class RicePartition {
+			public:
+
+			size_t rice_parameter;
+			size_t bit_count;
+
+			protected:
+		};
+
+		auto get_partition_offset(
+			size_t partition_order,
+			size_t partition_index
+		) -> size_t {
+			return (cdda::STEREO_SAMPLES_PER_SECTOR * partition_index) >> partition_order;
+		}
+
+		// Samples preceding the order of the predictor are predicted by extrapolating at most two samples.
+		auto get_prediction(
+			const si32_t* samples,
+			size_t sample_index,
+			const lpc::QuantizedPredictor& predictor
+		) -> si64_t {
+			auto& effective_predictor = sample_index < predictor.order ? FIXED_PREDICTORS.at(std::min<size_t>(sample_index, 2)) : predictor;
+			auto prediction = si64_t(0);
+			for (auto index = size_t(0); index < effective_predictor.order; index += 1) {
+				prediction += si64_t(effective_predictor.coefficients[index]) * samples[sample_index - 1 - index];
+			}
+			return prediction >> effective_predictor.shift;
+		}
+
+		auto get_lpc_subframe_header_bit_count(
+			const LPCSubframe& subframe
+		) -> size_t {
+			if (subframe.is_lpc) {
+				return 1 + BITS_PER_LPC_ORDER + BITS_PER_LPC_PRECISION + BITS_PER_LPC_SHIFT + subframe.predictor.order * subframe.predictor.precision;
+			} else {
+				return 1 + BITS_PER_FIXED_ORDER;
+			}
+		}
+
+		// Residuals outside of the signed 32-bit range are rejected by returning no sum.
+		auto compute_lpc_residuals(
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si32_t>& samples,
+			const lpc::QuantizedPredictor& predictor,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, ui32_t>& unsigned_residuals
+		) -> std::optional<size_t> {
+			auto sum = size_t(0);
+			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
+				auto residual = samples[sample_index] - get_prediction(samples, sample_index, predictor);
+				if (residual < INT32_MIN || residual > INT32_MAX) {
+					return std::optional<size_t>();
+				}
+				auto unsigned_residual = ui32_t((residual << 1) ^ (residual >> 63));
+				unsigned_residuals[sample_index] = unsigned_residual;
+				sum += unsigned_residual;
+			}
+			return sum;
+		}
+
+		auto get_partition_rice_coding_bit_count(
+			const ui32_t* unsigned_residuals,
+			size_t count,
+			size_t rice_parameter
+		) -> size_t {
+			auto bit_count = count * (rice_parameter + 1);
+			for (auto index = size_t(0); index < count; index += 1) {
+				bit_count += unsigned_residuals[index] >> rice_parameter;
+			}
+			return bit_count;
+		}
+
+		auto select_partition_rice_parameter(
+			const ui32_t* unsigned_residuals,
+			size_t count,
+			size_t sum
+		) -> RicePartition {
+			// The parameter is estimated and refined in the same way as for the LOSSLESS_STEREO_AUDIO method.
+			auto mean = count > 0 ? sum / count : 0;
+			auto rice_parameter = std::min<size_t>(mean > 0 ? std::bit_width(mean) - 1 : 0, MAX_PARTITION_RICE_PARAMETER - 1);
+			auto bit_count = get_partition_rice_coding_bit_count(unsigned_residuals, count, rice_parameter);
+			while (rice_parameter > 0) {
+				auto lower_bit_count = get_partition_rice_coding_bit_count(unsigned_residuals, count, rice_parameter - 1);
+				if (lower_bit_count > bit_count) {
+					break;
+				}
+				rice_parameter -= 1;
+				bit_count = lower_bit_count;
+			}
+			while (rice_parameter + 1 < MAX_PARTITION_RICE_PARAMETER) {
+				auto upper_bit_count = get_partition_rice_coding_bit_count(unsigned_residuals, count, rice_parameter + 1);
+				if (upper_bit_count >= bit_count) {
+					break;
+				}
+				rice_parameter += 1;
+				bit_count = upper_bit_count;
+			}
+			return {
+				rice_parameter,
+				bit_count
+			};
+		}
+
+		auto select_partitions(
+			LPCSubframe& subframe
+		) -> void {
+			array<cdda::STEREO_SAMPLES_PER_SECTOR + 1, size_t> prefix_sums;
+			prefix_sums[0] = 0;
+			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
+				prefix_sums[sample_index + 1] = prefix_sums[sample_index] + subframe.unsigned_residuals[sample_index];
+			}
+			auto best_bit_count = std::optional<size_t>();
+			for (auto partition_order = size_t(0); partition_order <= MAX_PARTITION_ORDER; partition_order += 1) {
+				array<(1 << MAX_PARTITION_ORDER), size_t> rice_parameters;
+				auto bit_count = BITS_PER_PARTITION_ORDER;
+				for (auto partition_index = size_t(0); partition_index < (size_t(1) << partition_order); partition_index += 1) {
+					auto first_index = get_partition_offset(partition_order, partition_index);
+					auto last_index = get_partition_offset(partition_order, partition_index + 1);
+					auto partition = select_partition_rice_parameter(subframe.unsigned_residuals + first_index, last_index - first_index, prefix_sums[last_index] - prefix_sums[first_index]);
+					rice_parameters[partition_index] = partition.rice_parameter;
+					bit_count += BITS_PER_PARTITION_RICE_PARAMETER + partition.bit_count;
+				}
+				if (!best_bit_count || bit_count < best_bit_count.value()) {
+					best_bit_count = bit_count;
+					subframe.partition_order = partition_order;
+					std::memcpy(subframe.rice_parameters, rice_parameters, sizeof(rice_parameters));
+				}
+			}
+			subframe.bit_count = get_lpc_subframe_header_bit_count(subframe) + best_bit_count.value();
+		}
+
+		// The fixed predictors and the linear predictor of the estimated best order are compared using a single rice partition before partitioning the best one.
+		auto encode_lpc_subframe(
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, const si32_t>& samples,
+			LPCSubframe& subframe
+		) -> void {
+			auto predictors = std::vector<lpc::QuantizedPredictor>(FIXED_PREDICTORS.begin(), FIXED_PREDICTORS.end());
+			array<lpc::MAX_ORDER + 1, fp64_t> autocorrelation;
+			lpc::compute_autocorrelation(samples, LPC_WINDOW.data(), cdda::STEREO_SAMPLES_PER_SECTOR, lpc::MAX_ORDER, autocorrelation);
+			array<lpc::MAX_ORDER, array<lpc::MAX_ORDER, fp64_t>> coefficients;
+			array<lpc::MAX_ORDER, fp64_t> errors;
+			auto order_count = lpc::compute_predictor_coefficients(autocorrelation, lpc::MAX_ORDER, coefficients, errors);
+			if (order_count > 0) {
+				auto order = lpc::estimate_best_order(errors, order_count, cdda::STEREO_SAMPLES_PER_SECTOR, LPC_PRECISION);
+				predictors.push_back(lpc::quantize_coefficients(coefficients[order - 1], order, LPC_PRECISION, MAX_LPC_SHIFT));
+			}
+			auto best_bit_count = std::optional<size_t>();
+			for (auto predictor_index = size_t(0); predictor_index < predictors.size(); predictor_index += 1) {
+				auto candidate = LPCSubframe();
+				candidate.is_lpc = predictor_index > MAX_FIXED_ORDER;
+				candidate.predictor = predictors.at(predictor_index);
+				auto sum = compute_lpc_residuals(samples, candidate.predictor, candidate.unsigned_residuals);
+				if (!sum) {
+					continue;
+				}
+				auto partition = select_partition_rice_parameter(candidate.unsigned_residuals, cdda::STEREO_SAMPLES_PER_SECTOR, sum.value());
+				auto bit_count = get_lpc_subframe_header_bit_count(candidate) + partition.bit_count;
+				if (!best_bit_count || bit_count < best_bit_count.value()) {
+					best_bit_count = bit_count;
+					subframe = candidate;
+				}
+			}
+			select_partitions(subframe);
+		}
+
+		auto write_lpc_subframe(
+			const LPCSubframe& subframe,
+			bits::BitWriter& bitwriter
+		) -> void {
+			auto& predictor = subframe.predictor;
+			bitwriter.append_bits(subframe.is_lpc ? 1 : 0, 1);
+			if (subframe.is_lpc) {
+				bitwriter.append_bits(predictor.order - 1, BITS_PER_LPC_ORDER);
+				bitwriter.append_bits(predictor.precision - 1, BITS_PER_LPC_PRECISION);
+				bitwriter.append_bits(predictor.shift, BITS_PER_LPC_SHIFT);
+				for (auto index = size_t(0); index < predictor.order; index += 1) {
+					bitwriter.append_bits(size_t(predictor.coefficients[index]), predictor.precision);
+				}
+			} else {
+				bitwriter.append_bits(predictor.order, BITS_PER_FIXED_ORDER);
+			}
+			bitwriter.append_bits(subframe.partition_order, BITS_PER_PARTITION_ORDER);
+			for (auto partition_index = size_t(0); partition_index < (size_t(1) << subframe.partition_order); partition_index += 1) {
+				auto first_index = get_partition_offset(subframe.partition_order, partition_index);
+				auto last_index = get_partition_offset(subframe.partition_order, partition_index + 1);
+				auto rice_parameter = subframe.rice_parameters[partition_index];
+				bitwriter.append_bits(rice_parameter, BITS_PER_PARTITION_RICE_PARAMETER);
+				bits::compress_data_using_rice_coding(subframe.unsigned_residuals + first_index, last_index - first_index, rice_parameter, bitwriter);
+			}
+		}
+
+		auto read_lpc_subframe(
+			bits::BitReader& bitreader,
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si32_t>& samples
+		) -> void {
+			auto predictor = lpc::QuantizedPredictor();
+			auto is_lpc = bitreader.decode_bits(1) == 1;
+			if (is_lpc) {
+				predictor.order = bitreader.decode_bits(BITS_PER_LPC_ORDER) + 1;
+				predictor.precision = bitreader.decode_bits(BITS_PER_LPC_PRECISION) + 1;
+				predictor.shift = bitreader.decode_bits(BITS_PER_LPC_SHIFT);
+				for (auto index = size_t(0); index < predictor.order; index += 1) {
+					auto value = bitreader.decode_bits(predictor.precision);
+					auto sign = size_t(1) << (predictor.precision - 1);
+					predictor.coefficients[index] = si32_t(si64_t(value ^ sign) - si64_t(sign));
+				}
+			} else {
+				auto order = bitreader.decode_bits(BITS_PER_FIXED_ORDER);
+				if (order > MAX_FIXED_ORDER) {
+					OVERDRIVE_THROW(exceptions::InvalidValueException("fixed predictor order", order, 0, MAX_FIXED_ORDER));
+				}
+				predictor = FIXED_PREDICTORS.at(order);
+			}
+			auto partition_order = bitreader.decode_bits(BITS_PER_PARTITION_ORDER);
+			if (partition_order > MAX_PARTITION_ORDER) {
+				OVERDRIVE_THROW(exceptions::InvalidValueException("partition order", partition_order, 0, MAX_PARTITION_ORDER));
+			}
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, ui32_t> unsigned_residuals;
+			for (auto partition_index = size_t(0); partition_index < (size_t(1) << partition_order); partition_index += 1) {
+				auto first_index = get_partition_offset(partition_order, partition_index);
+				auto last_index = get_partition_offset(partition_order, partition_index + 1);
+				auto rice_parameter = bitreader.decode_bits(BITS_PER_PARTITION_RICE_PARAMETER);
+				bits::decompress_data_using_rice_coding(unsigned_residuals + first_index, last_index - first_index, rice_parameter, bitreader);
+			}
+			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
+				auto unsigned_residual = unsigned_residuals[sample_index];
+				auto residual = si64_t(unsigned_residual >> 1) ^ (0 - si64_t(unsigned_residual & 1));
+				samples[sample_index] = si32_t(residual + get_prediction(samples, sample_index, predictor));
+			}
+		}
+
+		auto compress_sector_lossless_stereo_audio_lpc(
+			array<cd::SECTOR_LENGTH, byte_t>& target_sector_data
+		) -> std::optional<size_t> {
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> left;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> right;
+			simd::deinterleave_samples(target_sector_data, left, right, cdda::STEREO_SAMPLES_PER_SECTOR);
+			// The channels are ordered as left, right, side and mid.
+			array<4, array<cdda::STEREO_SAMPLES_PER_SECTOR, si32_t>> channels;
+			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
+				channels[0][sample_index] = left[sample_index];
+				channels[1][sample_index] = right[sample_index];
+				channels[2][sample_index] = si32_t(left[sample_index]) - right[sample_index];
+				channels[3][sample_index] = (si32_t(left[sample_index]) + right[sample_index]) >> 1;
+			}
+			array<4, LPCSubframe> subframes;
+			for (auto channel_index = size_t(0); channel_index < 4; channel_index += 1) {
+				encode_lpc_subframe(channels[channel_index], subframes[channel_index]);
+			}
+			const auto STEREO_MODE_CHANNELS = std::array<std::array<size_t, 2>, 4>({{
+				{ 0, 1 }, // Independent
+				{ 0, 2 }, // Left and side
+				{ 2, 1 }, // Side and right
+				{ 3, 2 } // Mid and side
+			}});
+			auto stereo_mode = StereoMode::INDEPENDENT;
+			auto bit_count = std::optional<size_t>();
+			for (auto mode = StereoMode::INDEPENDENT; mode <= StereoMode::MID_SIDE; mode += 1) {
+				auto& mode_channels = STEREO_MODE_CHANNELS.at(mode);
+				auto mode_bit_count = subframes[mode_channels.at(0)].bit_count + subframes[mode_channels.at(1)].bit_count;
+				if (!bit_count || mode_bit_count < bit_count.value()) {
+					stereo_mode = mode;
+					bit_count = mode_bit_count;
+				}
+			}
+			if (BITS_PER_STEREO_MODE + bit_count.value() > (cd::SECTOR_LENGTH - 1) * 8) {
+				return std::optional<size_t>();
+			}
+			auto bitwriter = bits::BitWriter(cd::SECTOR_LENGTH - 1);
+			bitwriter.append_bits(stereo_mode, BITS_PER_STEREO_MODE);
+			write_lpc_subframe(subframes[STEREO_MODE_CHANNELS.at(stereo_mode).at(0)], bitwriter);
+			write_lpc_subframe(subframes[STEREO_MODE_CHANNELS.at(stereo_mode).at(1)], bitwriter);
+			bitwriter.flush_bits();
+			if (bitwriter.is_size_exceeded()) {
+				return std::optional<size_t>();
+			}
+			auto& buffer = bitwriter.get_buffer();
+			std::memcpy(&target_sector_data, buffer.data(), buffer.size());
+			return buffer.size();
+		}
+
+		auto decompress_sector_lossless_stereo_audio_lpc(
+			array<cd::SECTOR_LENGTH, byte_t>& target_sector_data,
+			size_t compressed_byte_count
+		) -> void {
+			auto original = std::vector<byte_t>(compressed_byte_count);
+			std::memcpy(original.data(), &target_sector_data, compressed_byte_count);
+			auto bitreader = bits::BitReader(original, 0);
+			auto stereo_mode = bitreader.decode_bits(BITS_PER_STEREO_MODE);
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si32_t> channel_a;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si32_t> channel_b;
+			read_lpc_subframe(bitreader, channel_a);
+			read_lpc_subframe(bitreader, channel_b);
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> left;
+			array<cdda::STEREO_SAMPLES_PER_SECTOR, si16_t> right;
+			for (auto sample_index = size_t(0); sample_index < cdda::STEREO_SAMPLES_PER_SECTOR; sample_index += 1) {
+				auto a = si64_t(channel_a[sample_index]);
+				auto b = si64_t(channel_b[sample_index]);
+				if (stereo_mode == StereoMode::INDEPENDENT) {
+					left[sample_index] = si16_t(a);
+					right[sample_index] = si16_t(b);
+				} else if (stereo_mode == StereoMode::LEFT_SIDE) {
+					left[sample_index] = si16_t(a);
+					right[sample_index] = si16_t(a - b);
+				} else if (stereo_mode == StereoMode::RIGHT_SIDE) {
+					left[sample_index] = si16_t(a + b);
+					right[sample_index] = si16_t(b);
+				} else {
+					// The least significant bit of the mid channel is restored from the side channel.
+					auto mid = (a << 1) | (b & 1);
+					left[sample_index] = si16_t((mid + b) >> 1);
+					right[sample_index] = si16_t((mid - b) >> 1);
+				}
+			}
+			simd::interleave_samples(left, right, target_sector_data, cdda::STEREO_SAMPLES_PER_SECTOR);
 		}
 
 		auto compress_run_length_encoding(
 			byte_t* target_data,
 			size_t target_size
-		) -> size_t {
-			auto bitwriter = bits::BitWriter(target_size);
-			try {
-				bits::compress_data_using_rle_coding(target_data, target_size, bitwriter);
-				bitwriter.flush_bits();
-			} catch (exceptions::BitWriterSizeExceededError& e) {}
-			auto& buffer = bitwriter.get_buffer();
-			if (buffer.size() >= target_size) {
-				OVERDRIVE_THROW(exceptions::CompressedSizeExceededUncompressedSizeException(buffer.size(), target_size));
+		) -> std::optional<size_t> {
+			auto bitwriter = bits::BitWriter(target_size - 1);
+			bits::compress_data_using_rle_coding(target_data, target_size, bitwriter);
+			bitwriter.flush_bits();
+			if (bitwriter.is_size_exceeded()) {
+				return std::optional<size_t>();
 			}
+			auto& buffer = bitwriter.get_buffer();
 			std::memcpy(target_data, buffer.data(), buffer.size());
 			return buffer.size();
 		}
@@ -298,7 +671,7 @@ namespace odi {
 		auto do_compress_sector_data(
 			array<cd::SECTOR_LENGTH, byte_t>& sector_data,
 			SectorDataCompressionMethod::type compression_method
-		) -> size_t {
+		) -> std::optional<size_t> {
 			if (compression_method == SectorDataCompressionMethod::NONE) {
 				return sizeof(sector_data);
 			}
@@ -308,13 +681,16 @@ namespace odi {
 			if (compression_method == SectorDataCompressionMethod::LOSSLESS_STEREO_AUDIO) {
 				return compress_sector_lossless_stereo_audio(sector_data);
 			}
+			if (compression_method == SectorDataCompressionMethod::LOSSLESS_STEREO_AUDIO_LPC) {
+				return compress_sector_lossless_stereo_audio_lpc(sector_data);
+			}
 			OVERDRIVE_THROW(exceptions::UnreachableCodeReachedException());
 		}
 
 		auto do_compress_subchannels_data(
 			array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data,
 			SubchannelsDataCompressionMethod::type compression_method
-		) -> size_t {
+		) -> std::optional<size_t> {
 			if (compression_method == SubchannelsDataCompressionMethod::NONE) {
 				return sizeof(subchannels_data);
 			}
@@ -324,17 +700,31 @@ namespace odi {
 			OVERDRIVE_THROW(exceptions::UnreachableCodeReachedException());
 		}
 
+		auto read_file_header(
+			std::FILE* file
+		) -> FileHeader {
+			std::fseek(file, 0, SEEK_SET);
+			auto file_header = FileHeader();
+			if (std::fread(reinterpret_cast<byte_t*>(&file_header), sizeof(file_header), 1, file) != 1) {
+				OVERDRIVE_THROW(exceptions::IOReadException("(image)"));
+			}
+			if (file_header.major_version != MAJOR_VERSION) {
+				OVERDRIVE_THROW(exceptions::InvalidValueException("image major version", file_header.major_version, MAJOR_VERSION, MAJOR_VERSION));
+			}
+			// Images of a lower minor version are readable since every minor version only introduces new methods.
+			if (file_header.minor_version > MINOR_VERSION) {
+				OVERDRIVE_THROW(exceptions::InvalidValueException("image minor version", file_header.minor_version, 0, MINOR_VERSION));
+			}
+			return file_header;
+		}
+
 		auto do_read_point_table(
 			void* handle,
 			byte_t* data,
 			size_t data_size
 		) -> size_t {
 			auto* file = reinterpret_cast<std::FILE*>(handle);
-			std::fseek(file, 0, SEEK_SET);
-			auto file_header = FileHeader();
-			if (std::fread(reinterpret_cast<byte_t*>(&file_header), sizeof(file_header), 1, file) != 1) {
-				OVERDRIVE_THROW(exceptions::IOReadException("(image)"));
-			}
+			auto file_header = read_file_header(file);
 			std::fseek(file, file_header.point_table_header_absolute_offset, SEEK_SET);
 			auto point_table_header = PointTableHeader();
 			if (std::fread(reinterpret_cast<byte_t*>(&point_table_header), sizeof(point_table_header), 1, file) != 1) {
@@ -364,11 +754,7 @@ namespace odi {
 			si_t absolute_sector
 		) -> bool_t {
 			auto* file = reinterpret_cast<std::FILE*>(handle);
-			std::fseek(file, 0, SEEK_SET);
-			auto file_header = FileHeader();
-			if (std::fread(reinterpret_cast<byte_t*>(&file_header), sizeof(file_header), 1, file) != 1) {
-				OVERDRIVE_THROW(exceptions::IOReadException("(image)"));
-			}
+			auto file_header = read_file_header(file);
 			std::fseek(file, file_header.sector_table_header_absolute_offset, SEEK_SET);
 			auto sector_table_header = SectorTableHeader();
 			if (std::fread(reinterpret_cast<byte_t*>(&sector_table_header), sizeof(sector_table_header), 1, file) != 1) {
@@ -422,13 +808,16 @@ namespace odi {
 	auto compress_sector_data(
 		array<cd::SECTOR_LENGTH, byte_t>& sector_data,
 		SectorDataCompressionMethod::type compression_method
-	) -> size_t {
+	) -> std::optional<size_t> {
 		array<cd::SECTOR_LENGTH, byte_t> uncompressed_sector_data;
 		std::memcpy(&uncompressed_sector_data, &sector_data, cd::SECTOR_LENGTH);
 		auto compressed_byte_count = internal::do_compress_sector_data(sector_data, compression_method);
+		if (!compressed_byte_count) {
+			return compressed_byte_count;
+		}
 		array<cd::SECTOR_LENGTH, byte_t> decompressed_sector_data;
 		std::memcpy(&decompressed_sector_data, &sector_data, cd::SECTOR_LENGTH);
-		decompress_sector_data(decompressed_sector_data, compressed_byte_count, compression_method);
+		decompress_sector_data(decompressed_sector_data, compressed_byte_count.value(), compression_method);
 		if (std::memcmp(&decompressed_sector_data, &uncompressed_sector_data, cd::SECTOR_LENGTH) != 0) {
 			OVERDRIVE_THROW(exceptions::CompressionValidationError());
 		}
@@ -438,11 +827,26 @@ namespace odi {
 	auto compress_sector_data(
 		array<cd::SECTOR_LENGTH, byte_t>& sector_data,
 		SectorDataCompressionMethod::type compression_method
-	) -> size_t {
+	) -> std::optional<size_t> {
 		return internal::do_compress_sector_data(sector_data, compression_method);
 	}
 #endif
 
+	auto compress_sector_data_batch(
+		const std::vector<pointer<array<cd::SECTOR_LENGTH, byte_t>>>& sector_data,
+		const std::vector<SectorDataCompressionMethod::type>& compression_methods
+	) -> std::vector<std::optional<size_t>> {
+		auto compressed_byte_counts = std::vector<std::optional<size_t>>(sector_data.size());
+		auto tasks = std::vector<pool::task_t>();
+		for (auto sector_index = size_t(0); sector_index < sector_data.size(); sector_index += 1) {
+			tasks.push_back([&, sector_index]() -> void {
+				compressed_byte_counts.at(sector_index) = compress_sector_data(*sector_data.at(sector_index), compression_methods.at(sector_index));
+			});
+		}
+		pool::get_thread_pool().run(tasks);
+		return compressed_byte_counts;
+	}
+
 	auto decompress_sector_data(
 		array<cd::SECTOR_LENGTH, byte_t>& sector_data,
 		size_t compressed_byte_count,
@@ -457,6 +861,9 @@ namespace odi {
 		if (compression_method == SectorDataCompressionMethod::LOSSLESS_STEREO_AUDIO) {
 			return internal::decompress_sector_lossless_stereo_audio(sector_data, compressed_byte_count);
 		}
+		if (compression_method == SectorDataCompressionMethod::LOSSLESS_STEREO_AUDIO_LPC) {
+			return internal::decompress_sector_lossless_stereo_audio_lpc(sector_data, compressed_byte_count);
+		}
 		OVERDRIVE_THROW(exceptions::UnreachableCodeReachedException());
 	}
 
@@ -464,13 +871,16 @@ namespace odi {
 	auto compress_subchannels_data(
 		array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data,
 		SubchannelsDataCompressionMethod::type compression_method
-	) -> size_t {
+	) -> std::optional<size_t> {
 		array<cd::SUBCHANNELS_LENGTH, byte_t> uncompressed_subchannels_data;
 		std::memcpy(&uncompressed_subchannels_data, &subchannels_data, cd::SUBCHANNELS_LENGTH);
 		auto compressed_byte_count = internal::do_compress_subchannels_data(subchannels_data, compression_method);
+		if (!compressed_byte_count) {
+			return compressed_byte_count;
+		}
 		array<cd::SUBCHANNELS_LENGTH, byte_t> decompressed_subchannels_data;
 		std::memcpy(&decompressed_subchannels_data, &subchannels_data, cd::SUBCHANNELS_LENGTH);
-		decompress_subchannels_data(decompressed_subchannels_data, compressed_byte_count, compression_method);
+		decompress_subchannels_data(decompressed_subchannels_data, compressed_byte_count.value(), compression_method);
 		if (std::memcmp(&decompressed_subchannels_data, &uncompressed_subchannels_data, cd::SUBCHANNELS_LENGTH) != 0) {
 			OVERDRIVE_THROW(exceptions::CompressionValidationError());
 		}
@@ -480,7 +890,7 @@ namespace odi {
 	auto compress_subchannels_data(
 		array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data,
 		SubchannelsDataCompressionMethod::type compression_method
-	) -> size_t {
+	) -> std::optional<size_t> {
 		return internal::do_compress_subchannels_data(subchannels_data, compression_method);
 	}
 #endif
@@ -502,7 +912,8 @@ namespace odi {
 	auto create_detail(
 	) -> detail::Detail {
 		auto image_adapter = internal::create_image_adapter();
-		return emulator::create_detail(image_adapter);
+		// The emulated drive is served through a queue in order to exercise the same code paths as a queueing backend.
+		return detail::create_queued_detail(emulator::create_detail(image_adapter), detail::MAX_QUEUE_DEPTH);
 	}
 }
 }
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <optional>
 #include <string>
+#include <vector>
 #include "cd.h"
 #include "detail.h"
 #include "shared.h"
@@ -10,7 +12,7 @@ namespace odi {
 	using namespace shared;
 
 	const auto MAJOR_VERSION = size_t(1);
-	const auto MINOR_VERSION = size_t(0);
+	const auto MINOR_VERSION = size_t(1);
 
 	namespace SectorDataCompressionMethod {
 		using type = ui08_t;
@@ -18,10 +20,16 @@ namespace odi {
 		const auto NONE = type(0x00);
 		const auto RUN_LENGTH_ENCODING = type(0x01);
 		const auto LOSSLESS_STEREO_AUDIO = type(0x80);
+		const auto LOSSLESS_STEREO_AUDIO_LPC = type(0x81);
 
 		auto name(
 			type value
 		) -> const std::string&;
+
+		// Returns the minor version of the format in which the method was introduced.
+		auto get_minor_version(
+			type value
+		) -> size_t;
 	}
 
 	namespace SubchannelsDataCompressionMethod {
@@ -136,10 +144,17 @@ namespace odi {
 
 	#pragma pack(pop)
 
+	// Sectors that cannot be compressed to fewer bytes are left unchanged without a compressed byte count.
 	auto compress_sector_data(
 		array<cd::SECTOR_LENGTH, byte_t>& sector_data,
 		SectorDataCompressionMethod::type compression_method
-	) -> size_t;
+	) -> std::optional<size_t>;
+
+	// Compresses every sector concurrently using the process-wide thread pool.
+	auto compress_sector_data_batch(
+		const std::vector<pointer<array<cd::SECTOR_LENGTH, byte_t>>>& sector_data,
+		const std::vector<SectorDataCompressionMethod::type>& compression_methods
+	) -> std::vector<std::optional<size_t>>;
 
 	auto decompress_sector_data(
 		array<cd::SECTOR_LENGTH, byte_t>& sector_data,
@@ -147,10 +162,11 @@ namespace odi {
 		SectorDataCompressionMethod::type compression_method
 	) -> void;
 
+	// Subchannels that cannot be compressed to fewer bytes are left unchanged without a compressed byte count.
 	auto compress_subchannels_data(
 		array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data,
 		SubchannelsDataCompressionMethod::type compression_method
-	) -> size_t;
+	) -> std::optional<size_t>;
 
 	auto decompress_subchannels_data(
 		array<cd::SUBCHANNELS_LENGTH, byte_t>& subchannels_data,
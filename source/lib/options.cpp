@@ -191,6 +191,62 @@ namespace options {
 				options.max_audio_copies = std::atoi(matches.at(0).c_str());
 			}
 		}));
+		parsers.push_back(parser::Parser({
+			"rescue",
+			{},
+			"Specify whether to survey with skip-ahead before rescuing unreadable regions.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("false"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.rescue = matches.at(0) == "true";
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"max-memory",
+			{},
+			"Specify the maximum amount of memory in megabytes used for keeping sector candidates.",
+			std::regex("^([1-9][0-9]*)$"),
+			"integer",
+			false,
+			std::optional<std::string>(),
+			0,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.max_memory = size_t(std::atoll(matches.at(0).c_str())) * 1024 * 1024;
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"resume",
+			{},
+			"Specify whether to resume from the journal of an interrupted extraction.",
+			std::regex("^(true|false)$"),
+			"boolean",
+			false,
+			std::optional<std::string>("false"),
+			1,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.resume = matches.at(0) == "true";
+			}
+		}));
+		parsers.push_back(parser::Parser({
+			"accuraterip-database",
+			{},
+			"Specify which AccurateRip database file in the dBAR format to verify audio tracks against.",
+			std::regex("^(.+)$"),
+			"string",
+			false,
+			std::optional<std::string>(),
+			0,
+			1,
+			[&](const std::vector<std::string>& matches) -> void {
+				options.accuraterip_database = matches.at(0);
+			}
+		}));
 		return parsers;
 	}
 }
@@ -26,6 +26,10 @@ namespace options {
 		size_t max_audio_retries;
 		size_t min_audio_copies;
 		size_t max_audio_copies;
+		bool_t rescue;
+		std::optional<size_t> max_memory;
+		bool_t resume;
+		std::optional<std::string> accuraterip_database;
 
 		protected:
 	};
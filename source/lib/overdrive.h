@@ -19,15 +19,20 @@
 #include "exceptions.h"
 #include "idiv.h"
 #include "iso9660.h"
+#include "journal.h"
+#include "lpc.h"
 #include "mds.h"
 #include "memory.h"
 #include "odi.h"
 #include "options.h"
 #include "path.h"
 #include "parser.h"
+#include "pipeline.h"
+#include "pool.h"
 #include "scsi.h"
 #include "sense.h"
 #include "shared.h"
+#include "simd.h"
 #include "string.h"
 #include "task.h"
 #include "time.h"
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include "shared.h"
+
+namespace overdrive {
+namespace pipeline {
+	using namespace shared;
+
+	// Bounded queue connecting the workers of one pipeline stage to the workers of the next stage.
+	template <typename A>
+	class Queue {
+		public:
+
+		Queue(
+			size_t capacity,
+			size_t producer_count
+		) {
+			this->capacity = std::max<size_t>(1, capacity);
+			this->producer_count = producer_count;
+			this->cancelled = false;
+		}
+
+		// Blocks while the queue is full. Returns false when the queue has been cancelled.
+		auto push(
+			A&& value
+		) -> bool_t {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->condition.wait(lock, [&]() -> bool_t {
+				return this->cancelled || this->values.size() < this->capacity;
+			});
+			if (this->cancelled) {
+				return false;
+			}
+			this->values.push_back(std::move(value));
+			this->condition.notify_all();
+			return true;
+		}
+
+		// Blocks while the queue is empty. Returns an empty value once every producer has closed the queue and the queue has been drained.
+		auto pop(
+		) -> std::optional<A> {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->condition.wait(lock, [&]() -> bool_t {
+				return this->cancelled || this->values.size() > 0 || this->producer_count == 0;
+			});
+			if (this->cancelled || this->values.size() == 0) {
+				return std::optional<A>();
+			}
+			auto value = std::optional<A>(std::move(this->values.front()));
+			this->values.pop_front();
+			this->condition.notify_all();
+			return value;
+		}
+
+		// Returns an empty value instead of blocking when the queue is empty.
+		auto try_pop(
+		) -> std::optional<A> {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			if (this->cancelled || this->values.size() == 0) {
+				return std::optional<A>();
+			}
+			auto value = std::optional<A>(std::move(this->values.front()));
+			this->values.pop_front();
+			this->condition.notify_all();
+			return value;
+		}
+
+		// Called once by every producer when it will push no more values.
+		auto close(
+		) -> void {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			if (this->producer_count > 0) {
+				this->producer_count -= 1;
+			}
+			this->condition.notify_all();
+		}
+
+		// Discards all queued values and releases every blocked producer and consumer.
+		auto cancel(
+		) -> void {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->cancelled = true;
+			this->values.clear();
+			this->condition.notify_all();
+		}
+
+		protected:
+
+		size_t capacity;
+		size_t producer_count;
+		bool_t cancelled;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::deque<A> values;
+	};
+}
+}
@@ -0,0 +1,191 @@
+#include "pool.h"
+
+#include <algorithm>
+#include <exception>
+
+namespace overdrive {
+namespace pool {
+	namespace internal {
+	namespace {
+		class Batch {
+			public:
+
+			std::mutex mutex;
+			std::condition_variable condition;
+			size_t remaining_task_count;
+			std::exception_ptr exception;
+
+			protected:
+		};
+
+		std::mutex thread_pool_mutex;
+		std::unique_ptr<ThreadPool> thread_pool;
+	}
+	}
+
+	ThreadPool::ThreadPool(
+		size_t worker_count
+	) {
+		worker_count = std::max<size_t>(1, worker_count);
+		this->queued_task_count = 0;
+		this->next_worker_index = 0;
+		this->stopped = false;
+		for (auto worker_index = size_t(0); worker_index < worker_count; worker_index += 1) {
+			this->queues.push_back(std::make_unique<WorkerQueue>());
+		}
+		for (auto worker_index = size_t(0); worker_index < worker_count; worker_index += 1) {
+			this->threads.push_back(std::thread([this, worker_index]() -> void {
+				this->run_worker(worker_index);
+			}));
+		}
+	}
+
+	ThreadPool::~ThreadPool(
+	) {
+		{
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->stopped = true;
+		}
+		this->condition.notify_all();
+		for (auto& thread : this->threads) {
+			thread.join();
+		}
+	}
+
+	auto ThreadPool::get_worker_count(
+	) const -> size_t {
+		return this->threads.size();
+	}
+
+	auto ThreadPool::run(
+		const std::vector<task_t>& tasks
+	) -> void {
+		auto batch = std::make_shared<internal::Batch>();
+		batch->remaining_task_count = tasks.size();
+		for (auto& task : tasks) {
+			auto worker_index = size_t(0);
+			{
+				auto lock = std::unique_lock<std::mutex>(this->mutex);
+				worker_index = this->next_worker_index;
+				this->next_worker_index = (this->next_worker_index + 1) % this->queues.size();
+			}
+			this->push(worker_index, [batch, task]() -> void {
+				try {
+					task();
+				} catch (...) {
+					auto lock = std::unique_lock<std::mutex>(batch->mutex);
+					if (!batch->exception) {
+						batch->exception = std::current_exception();
+					}
+				}
+				auto lock = std::unique_lock<std::mutex>(batch->mutex);
+				batch->remaining_task_count -= 1;
+				if (batch->remaining_task_count == 0) {
+					batch->condition.notify_all();
+				}
+			});
+		}
+		while (true) {
+			{
+				auto lock = std::unique_lock<std::mutex>(batch->mutex);
+				if (batch->remaining_task_count == 0) {
+					break;
+				}
+			}
+			// The calling thread may be stealing tasks belonging to other batches which is harmless since every task completes its own batch.
+			auto task = this->pop(0);
+			if (task) {
+				task.value()();
+				continue;
+			}
+			auto lock = std::unique_lock<std::mutex>(batch->mutex);
+			batch->condition.wait(lock, [&]() -> bool_t {
+				return batch->remaining_task_count == 0;
+			});
+		}
+		if (batch->exception) {
+			std::rethrow_exception(batch->exception);
+		}
+	}
+
+	auto ThreadPool::push(
+		size_t worker_index,
+		task_t&& task
+	) -> void {
+		auto& queue = *this->queues.at(worker_index);
+		{
+			auto lock = std::unique_lock<std::mutex>(queue.mutex);
+			queue.tasks.push_back(std::move(task));
+		}
+		{
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->queued_task_count += 1;
+		}
+		this->condition.notify_one();
+	}
+
+	auto ThreadPool::pop(
+		size_t worker_index
+	) -> std::optional<task_t> {
+		auto task = std::optional<task_t>();
+		for (auto queue_offset = size_t(0); queue_offset < this->queues.size(); queue_offset += 1) {
+			auto& queue = *this->queues.at((worker_index + queue_offset) % this->queues.size());
+			auto lock = std::unique_lock<std::mutex>(queue.mutex);
+			if (queue.tasks.size() == 0) {
+				continue;
+			}
+			if (queue_offset == 0) {
+				task = std::move(queue.tasks.back());
+				queue.tasks.pop_back();
+			} else {
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+			}
+			break;
+		}
+		if (task) {
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->queued_task_count -= 1;
+		}
+		return task;
+	}
+
+	auto ThreadPool::run_worker(
+		size_t worker_index
+	) -> void {
+		while (true) {
+			auto task = this->pop(worker_index);
+			if (task) {
+				task.value()();
+				continue;
+			}
+			auto lock = std::unique_lock<std::mutex>(this->mutex);
+			this->condition.wait(lock, [&]() -> bool_t {
+				return this->stopped || this->queued_task_count > 0;
+			});
+			if (this->stopped) {
+				return;
+			}
+		}
+	}
+
+	auto set_worker_count(
+		size_t worker_count
+	) -> void {
+		auto lock = std::unique_lock<std::mutex>(internal::thread_pool_mutex);
+		if (internal::thread_pool && internal::thread_pool->get_worker_count() == std::max<size_t>(1, worker_count)) {
+			return;
+		}
+		internal::thread_pool = std::make_unique<ThreadPool>(worker_count);
+	}
+
+	auto get_thread_pool(
+	) -> ThreadPool& {
+		auto lock = std::unique_lock<std::mutex>(internal::thread_pool_mutex);
+		if (!internal::thread_pool) {
+			internal::thread_pool = std::make_unique<ThreadPool>(std::thread::hardware_concurrency());
+		}
+		return *internal::thread_pool;
+	}
+}
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "shared.h"
+
+namespace overdrive {
+namespace pool {
+	using namespace shared;
+
+	using task_t = std::function<void()>;
+
+	class WorkerQueue {
+		public:
+
+		std::mutex mutex;
+		std::deque<task_t> tasks;
+
+		protected:
+	};
+
+	// Every worker takes tasks from the back of its own queue and steals from the front of the other queues when its own queue is empty.
+	class ThreadPool {
+		public:
+
+		ThreadPool(
+			size_t worker_count
+		);
+
+		ThreadPool(
+			const ThreadPool& other
+		) = delete;
+
+		~ThreadPool(
+		);
+
+		auto get_worker_count(
+		) const -> size_t;
+
+		// Returns once all tasks have completed. The calling thread executes queued tasks while waiting and rethrows the first exception thrown by a task.
+		auto run(
+			const std::vector<task_t>& tasks
+		) -> void;
+
+		protected:
+
+		auto push(
+			size_t worker_index,
+			task_t&& task
+		) -> void;
+
+		auto pop(
+			size_t worker_index
+		) -> std::optional<task_t>;
+
+		auto run_worker(
+			size_t worker_index
+		) -> void;
+
+		std::vector<std::unique_ptr<WorkerQueue>> queues;
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable condition;
+		size_t queued_task_count;
+		size_t next_worker_index;
+		bool_t stopped;
+	};
+
+	// Replaces the process-wide pool and must not be called while the pool is in use.
+	auto set_worker_count(
+		size_t worker_count
+	) -> void;
+
+	auto get_thread_pool(
+	) -> ThreadPool&;
+}
+}
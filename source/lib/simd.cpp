@@ -0,0 +1,589 @@
+#include "simd.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if __x86_64__ || __i386__
+	#include <immintrin.h>
+	#define OVERDRIVE_SIMD_X86
+#endif
+
+namespace overdrive {
+namespace simd {
+	namespace internal {
+	namespace {
+		auto load_sample(
+			const byte_t* data
+		) -> si16_t {
+			auto sample = si16_t(0);
+			std::memcpy(&sample, data, sizeof(sample));
+			return sample;
+		}
+
+		auto store_sample(
+			byte_t* data,
+			si16_t sample
+		) -> void {
+			std::memcpy(data, &sample, sizeof(sample));
+		}
+
+		auto get_clamped_prediction(
+			const si16_t* samples,
+			size_t sample_index,
+			si_t m3,
+			si_t m2,
+			si_t m1
+		) -> si_t {
+			if (sample_index == 0) {
+				return 0;
+			}
+			auto sample_m3 = samples[sample_index >= 3 ? sample_index - 3 : 0];
+			auto sample_m2 = samples[sample_index >= 2 ? sample_index - 2 : 0];
+			auto sample_m1 = samples[sample_index - 1];
+			return m3 * sample_m3 + m2 * sample_m2 + m1 * sample_m1;
+		}
+
+		namespace portable {
+			auto deinterleave_samples(
+				const byte_t* interleaved_samples,
+				si16_t* samples_a,
+				si16_t* samples_b,
+				size_t count
+			) -> void {
+				for (auto sample_index = size_t(0); sample_index < count; sample_index += 1) {
+					samples_a[sample_index] = load_sample(interleaved_samples + sample_index * 4 + 0);
+					samples_b[sample_index] = load_sample(interleaved_samples + sample_index * 4 + 2);
+				}
+			}
+
+			auto interleave_samples(
+				const si16_t* samples_a,
+				const si16_t* samples_b,
+				byte_t* interleaved_samples,
+				size_t count
+			) -> void {
+				for (auto sample_index = size_t(0); sample_index < count; sample_index += 1) {
+					store_sample(interleaved_samples + sample_index * 4 + 0, samples_a[sample_index]);
+					store_sample(interleaved_samples + sample_index * 4 + 2, samples_b[sample_index]);
+				}
+			}
+
+			auto add_samples(
+				si16_t* target_samples,
+				const si16_t* samples,
+				size_t count
+			) -> void {
+				for (auto sample_index = size_t(0); sample_index < count; sample_index += 1) {
+					target_samples[sample_index] = si16_t(target_samples[sample_index] + samples[sample_index]);
+				}
+			}
+
+			auto subtract_samples(
+				si16_t* target_samples,
+				const si16_t* samples,
+				size_t count
+			) -> void {
+				for (auto sample_index = size_t(0); sample_index < count; sample_index += 1) {
+					target_samples[sample_index] = si16_t(target_samples[sample_index] - samples[sample_index]);
+				}
+			}
+
+			// Computes the residuals from the first index up to but not including the last index.
+			auto compute_prediction_residuals(
+				const si16_t* samples,
+				si16_t* residuals,
+				size_t first_index,
+				size_t last_index,
+				si_t m3,
+				si_t m2,
+				si_t m1
+			) -> void {
+				for (auto sample_index = first_index; sample_index < std::min<size_t>(last_index, 3); sample_index += 1) {
+					residuals[sample_index] = si16_t(samples[sample_index] - get_clamped_prediction(samples, sample_index, m3, m2, m1));
+				}
+				for (auto sample_index = std::max<size_t>(first_index, 3); sample_index < last_index; sample_index += 1) {
+					auto prediction = m3 * samples[sample_index - 3] + m2 * samples[sample_index - 2] + m1 * samples[sample_index - 1];
+					residuals[sample_index] = si16_t(samples[sample_index] - prediction);
+				}
+			}
+
+			auto zigzag_encode(
+				const si16_t* values,
+				ui16_t* unsigned_values,
+				size_t count
+			) -> size_t {
+				auto sum = size_t(0);
+				for (auto value_index = size_t(0); value_index < count; value_index += 1) {
+					auto value = values[value_index];
+					auto unsigned_value = ui16_t((value << 1) ^ (value >> 15));
+					unsigned_values[value_index] = unsigned_value;
+					sum += unsigned_value;
+				}
+				return sum;
+			}
+
+			auto sum_shifted(
+				const ui16_t* values,
+				size_t count,
+				size_t shift
+			) -> size_t {
+				auto sum = size_t(0);
+				for (auto value_index = size_t(0); value_index < count; value_index += 1) {
+					sum += values[value_index] >> shift;
+				}
+				return sum;
+			}
+		}
+
+#ifdef OVERDRIVE_SIMD_X86
+		auto is_sse2_supported(
+		) -> bool_t {
+			static const auto supported = bool_t(__builtin_cpu_supports("sse2"));
+			return supported;
+		}
+
+		auto is_avx2_supported(
+		) -> bool_t {
+			static const auto supported = bool_t(__builtin_cpu_supports("avx2"));
+			return supported;
+		}
+
+		namespace sse2 {
+			const auto VALUES_PER_VECTOR = size_t(8);
+
+			// The low and high bytes are summed separately since there is no horizontal sum of unsigned 16-bit integers.
+			__attribute__((target("sse2"))) auto accumulate_sum(
+				__m128i sums,
+				__m128i values
+			) -> __m128i {
+				auto zero = _mm_setzero_si128();
+				auto low_sums = _mm_sad_epu8(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), zero);
+				auto high_sums = _mm_sad_epu8(_mm_srli_epi16(values, 8), zero);
+				return _mm_add_epi64(sums, _mm_add_epi64(low_sums, _mm_slli_epi64(high_sums, 8)));
+			}
+
+			__attribute__((target("sse2"))) auto reduce_sum(
+				__m128i sums
+			) -> size_t {
+				alignas(16) ui64_t lanes[2];
+				_mm_store_si128(reinterpret_cast<__m128i*>(lanes), sums);
+				return lanes[0] + lanes[1];
+			}
+
+			__attribute__((target("sse2"))) auto deinterleave_samples(
+				const byte_t* interleaved_samples,
+				si16_t* samples_a,
+				si16_t* samples_b,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto one = _mm_loadu_si128(reinterpret_cast<const __m128i*>(interleaved_samples + sample_index * 4 + 0));
+					auto two = _mm_loadu_si128(reinterpret_cast<const __m128i*>(interleaved_samples + sample_index * 4 + 16));
+					auto one_a = _mm_srai_epi32(_mm_slli_epi32(one, 16), 16);
+					auto two_a = _mm_srai_epi32(_mm_slli_epi32(two, 16), 16);
+					auto one_b = _mm_srai_epi32(one, 16);
+					auto two_b = _mm_srai_epi32(two, 16);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(samples_a + sample_index), _mm_packs_epi32(one_a, two_a));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(samples_b + sample_index), _mm_packs_epi32(one_b, two_b));
+				}
+				portable::deinterleave_samples(interleaved_samples + vector_count * 4, samples_a + vector_count, samples_b + vector_count, count - vector_count);
+			}
+
+			__attribute__((target("sse2"))) auto interleave_samples(
+				const si16_t* samples_a,
+				const si16_t* samples_b,
+				byte_t* interleaved_samples,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples_a + sample_index));
+					auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples_b + sample_index));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(interleaved_samples + sample_index * 4 + 0), _mm_unpacklo_epi16(a, b));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(interleaved_samples + sample_index * 4 + 16), _mm_unpackhi_epi16(a, b));
+				}
+				portable::interleave_samples(samples_a + vector_count, samples_b + vector_count, interleaved_samples + vector_count * 4, count - vector_count);
+			}
+
+			__attribute__((target("sse2"))) auto add_samples(
+				si16_t* target_samples,
+				const si16_t* samples,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto target = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target_samples + sample_index));
+					auto source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + sample_index));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(target_samples + sample_index), _mm_add_epi16(target, source));
+				}
+				portable::add_samples(target_samples + vector_count, samples + vector_count, count - vector_count);
+			}
+
+			__attribute__((target("sse2"))) auto subtract_samples(
+				si16_t* target_samples,
+				const si16_t* samples,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto target = _mm_loadu_si128(reinterpret_cast<const __m128i*>(target_samples + sample_index));
+					auto source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + sample_index));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(target_samples + sample_index), _mm_sub_epi16(target, source));
+				}
+				portable::subtract_samples(target_samples + vector_count, samples + vector_count, count - vector_count);
+			}
+
+			__attribute__((target("sse2"))) auto compute_prediction_residuals(
+				const si16_t* samples,
+				si16_t* residuals,
+				size_t count,
+				si_t m3,
+				si_t m2,
+				si_t m1
+			) -> void {
+				auto first_index = std::min<size_t>(count, 3);
+				auto last_index = first_index + (count - first_index) / VALUES_PER_VECTOR * VALUES_PER_VECTOR;
+				portable::compute_prediction_residuals(samples, residuals, 0, first_index, m3, m2, m1);
+				auto vector_m3 = _mm_set1_epi16(si16_t(m3));
+				auto vector_m2 = _mm_set1_epi16(si16_t(m2));
+				auto vector_m1 = _mm_set1_epi16(si16_t(m1));
+				for (auto sample_index = first_index; sample_index < last_index; sample_index += VALUES_PER_VECTOR) {
+					auto sample = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + sample_index));
+					auto sample_m3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + sample_index - 3));
+					auto sample_m2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + sample_index - 2));
+					auto sample_m1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(samples + sample_index - 1));
+					auto prediction = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(vector_m3, sample_m3), _mm_mullo_epi16(vector_m2, sample_m2)), _mm_mullo_epi16(vector_m1, sample_m1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(residuals + sample_index), _mm_sub_epi16(sample, prediction));
+				}
+				portable::compute_prediction_residuals(samples, residuals, last_index, count, m3, m2, m1);
+			}
+
+			__attribute__((target("sse2"))) auto zigzag_encode(
+				const si16_t* values,
+				ui16_t* unsigned_values,
+				size_t count
+			) -> size_t {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				auto sums = _mm_setzero_si128();
+				for (auto value_index = size_t(0); value_index < vector_count; value_index += VALUES_PER_VECTOR) {
+					auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + value_index));
+					auto unsigned_value = _mm_xor_si128(_mm_slli_epi16(value, 1), _mm_srai_epi16(value, 15));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(unsigned_values + value_index), unsigned_value);
+					sums = accumulate_sum(sums, unsigned_value);
+				}
+				return reduce_sum(sums) + portable::zigzag_encode(values + vector_count, unsigned_values + vector_count, count - vector_count);
+			}
+
+			__attribute__((target("sse2"))) auto sum_shifted(
+				const ui16_t* values,
+				size_t count,
+				size_t shift
+			) -> size_t {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				auto vector_shift = _mm_cvtsi32_si128(si_t(shift));
+				auto sums = _mm_setzero_si128();
+				for (auto value_index = size_t(0); value_index < vector_count; value_index += VALUES_PER_VECTOR) {
+					auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + value_index));
+					sums = accumulate_sum(sums, _mm_srl_epi16(value, vector_shift));
+				}
+				return reduce_sum(sums) + portable::sum_shifted(values + vector_count, count - vector_count, shift);
+			}
+		}
+
+		namespace avx2 {
+			const auto VALUES_PER_VECTOR = size_t(16);
+
+			__attribute__((target("avx2"))) auto accumulate_sum(
+				__m256i sums,
+				__m256i values
+			) -> __m256i {
+				auto zero = _mm256_setzero_si256();
+				auto low_sums = _mm256_sad_epu8(_mm256_and_si256(values, _mm256_set1_epi16(0x00FF)), zero);
+				auto high_sums = _mm256_sad_epu8(_mm256_srli_epi16(values, 8), zero);
+				return _mm256_add_epi64(sums, _mm256_add_epi64(low_sums, _mm256_slli_epi64(high_sums, 8)));
+			}
+
+			__attribute__((target("avx2"))) auto reduce_sum(
+				__m256i sums
+			) -> size_t {
+				alignas(32) ui64_t lanes[4];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sums);
+				return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+			}
+
+			// The 128-bit lanes are packed separately and must be reordered afterwards.
+			__attribute__((target("avx2"))) auto deinterleave_samples(
+				const byte_t* interleaved_samples,
+				si16_t* samples_a,
+				si16_t* samples_b,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto one = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(interleaved_samples + sample_index * 4 + 0));
+					auto two = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(interleaved_samples + sample_index * 4 + 32));
+					auto one_a = _mm256_srai_epi32(_mm256_slli_epi32(one, 16), 16);
+					auto two_a = _mm256_srai_epi32(_mm256_slli_epi32(two, 16), 16);
+					auto one_b = _mm256_srai_epi32(one, 16);
+					auto two_b = _mm256_srai_epi32(two, 16);
+					auto a = _mm256_permute4x64_epi64(_mm256_packs_epi32(one_a, two_a), _MM_SHUFFLE(3, 1, 2, 0));
+					auto b = _mm256_permute4x64_epi64(_mm256_packs_epi32(one_b, two_b), _MM_SHUFFLE(3, 1, 2, 0));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(samples_a + sample_index), a);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(samples_b + sample_index), b);
+				}
+				portable::deinterleave_samples(interleaved_samples + vector_count * 4, samples_a + vector_count, samples_b + vector_count, count - vector_count);
+			}
+
+			// The 128-bit lanes are unpacked separately and must be reordered afterwards.
+			__attribute__((target("avx2"))) auto interleave_samples(
+				const si16_t* samples_a,
+				const si16_t* samples_b,
+				byte_t* interleaved_samples,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples_a + sample_index));
+					auto b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples_b + sample_index));
+					auto low = _mm256_unpacklo_epi16(a, b);
+					auto high = _mm256_unpackhi_epi16(a, b);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(interleaved_samples + sample_index * 4 + 0), _mm256_permute2x128_si256(low, high, 0x20));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(interleaved_samples + sample_index * 4 + 32), _mm256_permute2x128_si256(low, high, 0x31));
+				}
+				portable::interleave_samples(samples_a + vector_count, samples_b + vector_count, interleaved_samples + vector_count * 4, count - vector_count);
+			}
+
+			__attribute__((target("avx2"))) auto add_samples(
+				si16_t* target_samples,
+				const si16_t* samples,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto target = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target_samples + sample_index));
+					auto source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + sample_index));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(target_samples + sample_index), _mm256_add_epi16(target, source));
+				}
+				portable::add_samples(target_samples + vector_count, samples + vector_count, count - vector_count);
+			}
+
+			__attribute__((target("avx2"))) auto subtract_samples(
+				si16_t* target_samples,
+				const si16_t* samples,
+				size_t count
+			) -> void {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				for (auto sample_index = size_t(0); sample_index < vector_count; sample_index += VALUES_PER_VECTOR) {
+					auto target = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(target_samples + sample_index));
+					auto source = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + sample_index));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(target_samples + sample_index), _mm256_sub_epi16(target, source));
+				}
+				portable::subtract_samples(target_samples + vector_count, samples + vector_count, count - vector_count);
+			}
+
+			__attribute__((target("avx2"))) auto compute_prediction_residuals(
+				const si16_t* samples,
+				si16_t* residuals,
+				size_t count,
+				si_t m3,
+				si_t m2,
+				si_t m1
+			) -> void {
+				auto first_index = std::min<size_t>(count, 3);
+				auto last_index = first_index + (count - first_index) / VALUES_PER_VECTOR * VALUES_PER_VECTOR;
+				portable::compute_prediction_residuals(samples, residuals, 0, first_index, m3, m2, m1);
+				auto vector_m3 = _mm256_set1_epi16(si16_t(m3));
+				auto vector_m2 = _mm256_set1_epi16(si16_t(m2));
+				auto vector_m1 = _mm256_set1_epi16(si16_t(m1));
+				for (auto sample_index = first_index; sample_index < last_index; sample_index += VALUES_PER_VECTOR) {
+					auto sample = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + sample_index));
+					auto sample_m3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + sample_index - 3));
+					auto sample_m2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + sample_index - 2));
+					auto sample_m1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(samples + sample_index - 1));
+					auto prediction = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(vector_m3, sample_m3), _mm256_mullo_epi16(vector_m2, sample_m2)), _mm256_mullo_epi16(vector_m1, sample_m1));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(residuals + sample_index), _mm256_sub_epi16(sample, prediction));
+				}
+				portable::compute_prediction_residuals(samples, residuals, last_index, count, m3, m2, m1);
+			}
+
+			__attribute__((target("avx2"))) auto zigzag_encode(
+				const si16_t* values,
+				ui16_t* unsigned_values,
+				size_t count
+			) -> size_t {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				auto sums = _mm256_setzero_si256();
+				for (auto value_index = size_t(0); value_index < vector_count; value_index += VALUES_PER_VECTOR) {
+					auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + value_index));
+					auto unsigned_value = _mm256_xor_si256(_mm256_slli_epi16(value, 1), _mm256_srai_epi16(value, 15));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(unsigned_values + value_index), unsigned_value);
+					sums = accumulate_sum(sums, unsigned_value);
+				}
+				return reduce_sum(sums) + portable::zigzag_encode(values + vector_count, unsigned_values + vector_count, count - vector_count);
+			}
+
+			__attribute__((target("avx2"))) auto sum_shifted(
+				const ui16_t* values,
+				size_t count,
+				size_t shift
+			) -> size_t {
+				auto vector_count = count - count % VALUES_PER_VECTOR;
+				auto vector_shift = _mm_cvtsi32_si128(si_t(shift));
+				auto sums = _mm256_setzero_si256();
+				for (auto value_index = size_t(0); value_index < vector_count; value_index += VALUES_PER_VECTOR) {
+					auto value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + value_index));
+					sums = accumulate_sum(sums, _mm256_srl_epi16(value, vector_shift));
+				}
+				return reduce_sum(sums) + portable::sum_shifted(values + vector_count, count - vector_count, shift);
+			}
+		}
+#endif
+	}
+	}
+
+	auto deinterleave_samples(
+		const byte_t* interleaved_samples,
+		si16_t* samples_a,
+		si16_t* samples_b,
+		size_t count
+	) -> void {
+#ifdef OVERDRIVE_SIMD_X86
+		if (internal::is_avx2_supported()) {
+			return internal::avx2::deinterleave_samples(interleaved_samples, samples_a, samples_b, count);
+		}
+		if (internal::is_sse2_supported()) {
+			return internal::sse2::deinterleave_samples(interleaved_samples, samples_a, samples_b, count);
+		}
+#endif
+		return internal::portable::deinterleave_samples(interleaved_samples, samples_a, samples_b, count);
+	}
+
+	auto interleave_samples(
+		const si16_t* samples_a,
+		const si16_t* samples_b,
+		byte_t* interleaved_samples,
+		size_t count
+	) -> void {
+#ifdef OVERDRIVE_SIMD_X86
+		if (internal::is_avx2_supported()) {
+			return internal::avx2::interleave_samples(samples_a, samples_b, interleaved_samples, count);
+		}
+		if (internal::is_sse2_supported()) {
+			return internal::sse2::interleave_samples(samples_a, samples_b, interleaved_samples, count);
+		}
+#endif
+		return internal::portable::interleave_samples(samples_a, samples_b, interleaved_samples, count);
+	}
+
+	auto add_samples(
+		si16_t* target_samples,
+		const si16_t* samples,
+		size_t count
+	) -> void {
+#ifdef OVERDRIVE_SIMD_X86
+		if (internal::is_avx2_supported()) {
+			return internal::avx2::add_samples(target_samples, samples, count);
+		}
+		if (internal::is_sse2_supported()) {
+			return internal::sse2::add_samples(target_samples, samples, count);
+		}
+#endif
+		return internal::portable::add_samples(target_samples, samples, count);
+	}
+
+	auto subtract_samples(
+		si16_t* target_samples,
+		const si16_t* samples,
+		size_t count
+	) -> void {
+#ifdef OVERDRIVE_SIMD_X86
+		if (internal::is_avx2_supported()) {
+			return internal::avx2::subtract_samples(target_samples, samples, count);
+		}
+		if (internal::is_sse2_supported()) {
+			return internal::sse2::subtract_samples(target_samples, samples, count);
+		}
+#endif
+		return internal::portable::subtract_samples(target_samples, samples, count);
+	}
+
+	auto compute_prediction_residuals(
+		const si16_t* samples,
+		si16_t* residuals,
+		size_t count,
+		si_t m3,
+		si_t m2,
+		si_t m1
+	) -> void {
+#ifdef OVERDRIVE_SIMD_X86
+		if (internal::is_avx2_supported()) {
+			return internal::avx2::compute_prediction_residuals(samples, residuals, count, m3, m2, m1);
+		}
+		if (internal::is_sse2_supported()) {
+			return internal::sse2::compute_prediction_residuals(samples, residuals, count, m3, m2, m1);
+		}
+#endif
+		return internal::portable::compute_prediction_residuals(samples, residuals, 0, count, m3, m2, m1);
+	}
+
+	auto apply_prediction_residuals(
+		const si16_t* residuals,
+		si16_t* samples,
+		size_t count,
+		si_t m3,
+		si_t m2,
+		si_t m1
+	) -> void {
+		for (auto sample_index = size_t(0); sample_index < std::min<size_t>(count, 3); sample_index += 1) {
+			samples[sample_index] = si16_t(residuals[sample_index] + internal::get_clamped_prediction(samples, sample_index, m3, m2, m1));
+		}
+		if (count <= 3) {
+			return;
+		}
+		// The preceding samples are kept in registers in order to shorten the dependency chain.
+		auto sample_m3 = si_t(samples[0]);
+		auto sample_m2 = si_t(samples[1]);
+		auto sample_m1 = si_t(samples[2]);
+		for (auto sample_index = size_t(3); sample_index < count; sample_index += 1) {
+			auto sample = si16_t(residuals[sample_index] + m3 * sample_m3 + m2 * sample_m2 + m1 * sample_m1);
+			samples[sample_index] = sample;
+			sample_m3 = sample_m2;
+			sample_m2 = sample_m1;
+			sample_m1 = sample;
+		}
+	}
+
+	auto zigzag_encode(
+		const si16_t* values,
+		ui16_t* unsigned_values,
+		size_t count
+	) -> size_t {
+#ifdef OVERDRIVE_SIMD_X86
+		if (internal::is_avx2_supported()) {
+			return internal::avx2::zigzag_encode(values, unsigned_values, count);
+		}
+		if (internal::is_sse2_supported()) {
+			return internal::sse2::zigzag_encode(values, unsigned_values, count);
+		}
+#endif
+		return internal::portable::zigzag_encode(values, unsigned_values, count);
+	}
+
+	auto sum_shifted(
+		const ui16_t* values,
+		size_t count,
+		size_t shift
+	) -> size_t {
+#ifdef OVERDRIVE_SIMD_X86
+		if (internal::is_avx2_supported()) {
+			return internal::avx2::sum_shifted(values, count, shift);
+		}
+		if (internal::is_sse2_supported()) {
+			return internal::sse2::sum_shifted(values, count, shift);
+		}
+#endif
+		return internal::portable::sum_shifted(values, count, shift);
+	}
+}
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "shared.h"
+
+// The kernels use AVX2 or SSE2 when supported by the processor and portable loops otherwise.
+// All arithmetic wraps around like arithmetic on 16-bit integers.
+
+namespace overdrive {
+namespace simd {
+	using namespace shared;
+
+	// Splits interleaved 16-bit stereo samples into one array per channel.
+	auto deinterleave_samples(
+		const byte_t* interleaved_samples,
+		si16_t* samples_a,
+		si16_t* samples_b,
+		size_t count
+	) -> void;
+
+	auto interleave_samples(
+		const si16_t* samples_a,
+		const si16_t* samples_b,
+		byte_t* interleaved_samples,
+		size_t count
+	) -> void;
+
+	auto add_samples(
+		si16_t* target_samples,
+		const si16_t* samples,
+		size_t count
+	) -> void;
+
+	auto subtract_samples(
+		si16_t* target_samples,
+		const si16_t* samples,
+		size_t count
+	) -> void;
+
+	// Predicts every sample except the first from the three preceding samples where samples before the first sample are replaced by the first sample.
+	auto compute_prediction_residuals(
+		const si16_t* samples,
+		si16_t* residuals,
+		size_t count,
+		si_t m3,
+		si_t m2,
+		si_t m1
+	) -> void;
+
+	// Reverses compute_prediction_residuals(). Every sample depends on the preceding samples and is therefore computed sequentially.
+	auto apply_prediction_residuals(
+		const si16_t* residuals,
+		si16_t* samples,
+		size_t count,
+		si_t m3,
+		si_t m2,
+		si_t m1
+	) -> void;
+
+	// Maps signed values to unsigned values so that values of small magnitude become small and returns the sum of the unsigned values.
+	auto zigzag_encode(
+		const si16_t* values,
+		ui16_t* unsigned_values,
+		size_t count
+	) -> size_t;
+
+	auto sum_shifted(
+		const ui16_t* values,
+		size_t count,
+		size_t shift
+	) -> size_t;
+}
+}